@@ -10,7 +10,9 @@
  *                  The circuits are defined in a specific format. Please refer to the
  *                  README file for more details on the format of the circuit.
  *
- *                  The ATPG uses an algorithm that is somewhat similar to PODEM.
+ *                  The ATPG uses the PODEM algorithm to generate one test per fault.
+ *                  The older exhaustive search over all input vectors can still be
+ *                  selected with the -e option.
  *                  After it generates the vectors, it simulates the circuit for a
  *                  given fault list and gives the test vectors that can test each
  *                  fault from the given fault file.
@@ -53,6 +55,18 @@
 #include <map>
 #include <algorithm>
 #include <math.h>
+#include <unistd.h>
+#include <stdint.h>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <climits>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 
 #include "lib/forward_implication.cc"   // Contains the forward implication functions.
@@ -64,6 +78,21 @@
 #include "class/CircuitLine.cc"         // This class stores the line number and stuck at faults. Both faults for unique line.
 #include "class/FaultList.cc"           // This class stores the line number and stuck at fault. Only one fault, for analysis.
 #include "class/TestList.cc"            // This class contains the line number, fault and test vector with a flag to indicate if test is possible.
+#include "class/CircuitGraph.cc"        // Line number table and flat fan in / fan out arrays of the circuit.
+#include "class/StaticLearning.cc"     // Implications between line values learnt once for the circuit.
+#include "class/ImplicationEngine.cc"  // Forward and backward implication of one line value.
+#include "class/PodemSearch.cc"         // PODEM test generation for one fault at a time.
+#include "class/FaultSimulator.cc"      // Grades test vectors against faults, a block of vectors at a time.
+#include "class/ConcurrentSimulator.cc" // Grades test vectors against faults, one vector and all faults at a time.
+#include "class/SatSolver.cc"          // CDCL solver for formulas in conjunctive normal form.
+#include "class/SatAtpg.cc"            // Test generation for one fault at a time as a SAT problem.
+#include "class/VectorEnumerator.cc"    // Input vectors for the exhaustive search, one at a time.
+#include "class/WorkQueue.cc"           // Hands out work items to the worker threads.
+#include "class/AtpgWorkers.cc"         // Test generation and grading on several threads.
+#include "class/FaultClasses.cc"        // Equivalence classes of the faults, for fault collapsing.
+#include "class/CircuitCache.cc"        // Binary copy of the prepared circuit, for later runs.
+#include "class/FileScanner.cc"         // Reads the numbers in the circuit and fault list files.
+#include "class/PatternGenerator.cc"    // Pseudo random input vectors from a seed.
 
 // Global constant definitions.
 
@@ -84,6 +113,13 @@ using namespace nameSpace_ATPG;
  */
 vector <CircuitNode> masterNodeList;
 
+/*
+ * Connections between the nodes in masterNodeList, as node indices. It is
+ * built once the circuit is read and used wherever the circuit is walked
+ * through, instead of searching masterNodeList for line numbers.
+ */
+CircuitGraph masterCircuitGraph;
+
 /*
  * This map contains the objects of CircuitLine. Reason to use map was that
  * we need only unique line numbers for the CircuitLine objects. So, the line
@@ -93,12 +129,18 @@ vector <CircuitNode> masterNodeList;
 map <int, CircuitLine> masterLineList;
 
 /*
- * This vector contains the list of all possible inputs to a circuit in a 3
- * valued logic. It contains strings. Width of the string is euqal to the
- * number of inputs to the circuit. It will later be split into integers
- * while applying to the circuit.
+ * Equivalence classes of all the faults in the circuit. Only the representative
+ * of each class is a target for test generation, and its result is given to
+ * every fault in the class.
+ */
+FaultClasses masterFaultClasses;
+
+/*
+ * This vector contains the test vectors for the circuit, in a 3 valued logic.
+ * It contains strings. Width of the string is euqal to the number of inputs
+ * to the circuit. It will later be split into integers while applying to the
+ * circuit.
  */
-vector <string> masterInputVector;
 vector <string> masterTestVector;
 
 /*
@@ -118,14 +160,103 @@ vector <FaultList> providedFaultList;
 vector <TestList> masterTestList;
 vector <TestList> finalTestList;
 
+/*
+ * Algorithm used to generate the tests. PODEM by default, the exhaustive
+ * search is selected with the -e option and FAN with the -f option.
+ */
+int atpgAlgorithm = ATPG_PODEM;
+
+/*
+ * If this is set (-d option), every test found by PODEM is simulated against
+ * the faults that are still waiting for a test. The faults it detects are
+ * dropped and get the same test without a search of their own.
+ */
+bool isFaultDropping = false;
+
+// Number of worker threads for test generation and grading.
+int numberThreads = 1;
+
+/*
+ * If this is set (-c option), the classes of faults that dominate other faults
+ * are also removed from the targets for test generation.
+ */
+bool isDominanceCollapsing = false;
+
+/*
+ * If this is set (-s option), CheckAllFaultsATPG grades the vectors with the
+ * concurrent fault simulator, one vector at a time, instead of a block of
+ * vectors at a time.
+ */
+bool isConcurrentSimulation = false;
+
+/*
+ * If this is set (-t option), the fault simulation uses critical path tracing in
+ * the fanout-free regions, see FaultSimulator.
+ */
+bool isPathTracing = false;
+
+/*
+ * If this is set (-r option), random patterns are tried before the test
+ * generation, see RandomPatternATPG. The seed is given with -r, and the gain
+ * threshold in percent with -R.
+ */
+bool isRandomPhase = false;
+uint64_t randomSeed = 1;
+double randomMinimumGain = RANDOM_MIN_GAIN;
+
+// Order of the faults for PODEM (-o option), ORDER_LIST etc.
+int faultOrder = ORDER_LIST;
+
+/*
+ * Limits of the PODEM search, 0 for no limit. A fault is aborted when its search
+ * takes more backtracks (-b option) or seconds (-p option) than this. With the
+ * -T option no search goes on after runStopTime, and the faults left are aborted.
+ */
+unsigned long backtrackLimit = DEFAULT_BACKTRACK_LIMIT;
+bool isBacktrackLimitSet = false;
+double faultTimeLimit = 0;
+chrono::steady_clock::time_point runStopTime = chrono::steady_clock::time_point::max();
+
+// The tests are compacted after the test generation (-m option), see CompactTests.
+bool isStaticCompaction = false;
+
+// The faults PODEM aborts are given to the SAT search (-S option).
+bool isSatFallback = false;
+
+/*
+ * Dynamic compaction (-x option), the number of other faults that every new test
+ * is extended for, 0 for none. See AtpgWorkers.
+ */
+int compactionTargets = 0;
+
+/*
+ * Static learning (-l option). The implications are learnt once, or loaded from
+ * the learning file of the circuit, and used by PODEM.
+ */
+bool isStaticLearning = false;
+StaticLearning masterStaticLearning (masterNodeList, masterCircuitGraph);
+
+/*
+ * Circuit cache (-k option). The circuit is loaded from its cache file when the
+ * file matches, and isCircuitLoaded is set, so it is not read, levelized or
+ * collapsed again. Otherwise the cache file is written once it is ready.
+ */
+bool isCircuitCache = false;
+bool isCircuitLoaded = false;
+CircuitCache masterCircuitCache (masterNodeList, masterCircuitGraph, masterFaultClasses);
+
 /*
  * ===  FUNCTION  ======================================================================
  *         Name:  ReadCircuit
  *  Description:  This function, once it can successfully open the circuit file, will
  *                then populate the structure/class with the proper values from the file.
+ *
+ *                The file is mapped into memory and read with a FileScanner, and the
+ *                nodes are built in place in masterNodeList. A line that does not
+ *                fit the format is reported with its line and column.
  * =====================================================================================
  */
-void ReadCircuit (ifstream &inFile) {
+void ReadCircuit (char *inFileName) {
 
     #ifdef DEBUG
         WRITE << "================================================================================" << endl;
@@ -133,98 +264,89 @@ void ReadCircuit (ifstream &inFile) {
         WRITE << "================================================================================" << endl << endl;
     #endif
 
+    FileScanner inFile (inFileName);
     unsigned int nodeType;
-    unsigned int fanInListMember;
+    unsigned int gateType;
+    vector <unsigned int> fanInLines;               // Inputs of all the nodes, in file order.
 
-    while (true) {
-        inFile >> nodeType;                         // This is the type of current node.
-        if (inFile.eof())
-            break;
-        CircuitNode *thisNode;
-        thisNode = new CircuitNode (nodeType);      // Constructor checks for inputs and outputs.
+    // Every node is one line of the file.
+    masterNodeList.reserve(inFile.NumberLines());
+
+    while (inFile.NextRecord()) {
+        nodeType = inFile.ReadNumber();             // This is the type of current node.
+        if (nodeType != PI && nodeType != FB && nodeType != GT && nodeType != PO) {
+            inFile.Error("Undefined Node Type. Valid values are 0, 1, 2 and 3.");
+        }
+        masterNodeList.emplace_back(nodeType);      // Constructor checks for inputs and outputs.
+        CircuitNode *thisNode = &masterNodeList.back();
 
         switch (nodeType) {
             case PI:                                // Check if the current node is a primary input.
-                inFile >> thisNode->lineNumber;     // Unique ID for the line.
-                inFile >> thisNode->gateType;       // This will be always 0 for primary inputs.
-                inFile >> thisNode->numberFanOut;   // Number of lines connected to this input.
-                inFile >> thisNode->numberFanIn;    // This will always be 0 for primary inputs.
+                thisNode->lineNumber = inFile.ReadNumber();     // Unique ID for the line.
+                gateType = inFile.ReadNumber();                 // This will be always 0 for primary inputs.
+                if (gateType > G_XNOR)
+                    inFile.Error("Undefined Gate Type. Valid values are 0 to 8.");
+                thisNode->numberFanOut = inFile.ReadNumber();   // Number of lines connected to this input.
+                thisNode->numberFanIn = inFile.ReadNumber();    // This will always be 0 for primary inputs.
+                if (thisNode->numberFanIn != 0)
+                    inFile.Error("A primary input can not have inputs.");
                 break;
 
             case FB:
-                inFile >> thisNode->lineNumber;     // Unique ID for the line.
-                inFile >> thisNode->gateType;       // This will be always 1 for branches.
+                thisNode->lineNumber = inFile.ReadNumber();     // Unique ID for the line.
+                gateType = inFile.ReadNumber();                 // This will be always 1 for branches.
+                if (gateType < G_BRNCH || gateType > G_XNOR)
+                    inFile.Error("Undefined Gate Type. Valid values are 1 to 8.");
                 thisNode->numberFanIn = 1;          // Branch always has only one input.
                 thisNode->numberFanOut = 100;       // Branch can have multiple outputs but only one per line.
                 //TODO: Figure this out - 100 is incorrect. Needs to be proper value.
-                inFile >> fanInListMember;          // This is the fan out for branch.
-                thisNode->listFanIn.insert(fanInListMember);
+                fanInLines.push_back(inFile.ReadNumber());      // This is the fan out for branch.
                 break;
 
-            case GT:
-                inFile >> thisNode->lineNumber;     // Unique ID for the line.
-                inFile >> thisNode->gateType;       // Gate type.
-                inFile >> thisNode->numberFanOut;   // Number of lines connected to this node.
-                inFile >> thisNode->numberFanIn;    // Number of lines connected at this node.
+            case GT:                                // Gate, or
+            case PO:                                // primary output with the type of the gate it is connected to.
+                thisNode->lineNumber = inFile.ReadNumber();     // Unique ID for the line.
+                gateType = inFile.ReadNumber();                 // Gate type.
+                if (gateType < G_BRNCH || gateType > G_XNOR)
+                    inFile.Error("Undefined Gate Type. Valid values are 1 to 8.");
+                thisNode->numberFanOut = inFile.ReadNumber();   // Number of lines connected to this node.
+                thisNode->numberFanIn = inFile.ReadNumber();    // Number of lines connected at this node.
+                if (thisNode->numberFanIn == 0)
+                    inFile.Error("A gate must have at least one input.");
+                if ((gateType == G_BRNCH || gateType == G_NOT) && thisNode->numberFanIn > 1)
+                    inFile.Error("A branch or NOT gate can only have one input.");
                 for (int i = 0; i < thisNode->numberFanIn; i++) {
-                    inFile >> fanInListMember;
-                    thisNode->listFanIn.insert(fanInListMember);
+                    fanInLines.push_back(inFile.ReadNumber());
                 }
                 break;
-
-            case PO:
-                inFile >> thisNode->lineNumber;     // Unique ID for the line.
-                inFile >> thisNode->gateType;       // Type of the gate output is connected to.
-                inFile >> thisNode->numberFanOut;   // Always zero for outputs.
-                inFile >> thisNode->numberFanIn;    // Number of lines connected at this node.
-                for (int i = 0; i < thisNode->numberFanIn; i++) {
-                    inFile >> fanInListMember;
-                    thisNode->listFanIn.insert(fanInListMember);
-                }
-                break;
-
-            default:                                // Undefined node type.
-                cerr << "ERROR: Undefined Node Type." << endl
-                     << "Valid values are 0, 1, 2 and 3." << endl
-                     << "Current value is " << nodeType << endl;
-                exit (1);
-                break;                              // No necessary since exit (1) will end program.
         }
 
-        masterNodeList.push_back(*thisNode);
-        delete thisNode;
+        inFile.EndRecord();
+        thisNode->gateType = gateType;
     }
 
-    set <int>::iterator it, ij;
-    for (int i = 0; i < masterNodeList.size(); i++) {
-        for(it = masterNodeList[i].listFanIn.begin(); it != masterNodeList[i].listFanIn.end(); it++) {
-            for (int j = 0; j < masterNodeList.size(); j++) {
-                if (masterNodeList[j].lineNumber == *it)
-                    masterNodeList[j].listFanOut.insert(masterNodeList[i].lineNumber);
-            }
-        }
-    }
+    // Build the line number table and the fan in / fan out arrays.
+    masterCircuitGraph.Build(masterNodeList, fanInLines);
 
     #ifdef DEBUG
-        set <int>::iterator itr;
         for (int i = 0; i < masterNodeList.size(); i++) {
             WRITE << "------------------------------------------------------------" << endl;
             WRITE << "\tProperties Associated With Each Node" << endl;
             WRITE << "------------------------------------------------------------" << endl;
             WRITE << "nodeIndex = " << masterNodeList[i].nodeIndex << endl;
-            WRITE << "nodeType = " << masterNodeList[i].nodeType << endl;
+            WRITE << "nodeType = " << (int) masterNodeList[i].nodeType << endl;
             WRITE << "lineNumber = " << masterNodeList[i].lineNumber << endl;
-            WRITE << "gateType = " << masterNodeList[i].gateType << endl;
+            WRITE << "gateType = " << (int) masterNodeList[i].gateType << endl;
             WRITE << "numberFanOut = " << masterNodeList[i].numberFanOut << endl;
             WRITE << "numberFanIn = " << masterNodeList[i].numberFanIn << endl;
             WRITE << "listFanIn = ";
-            for(itr = masterNodeList[i].listFanIn.begin(); itr != masterNodeList[i].listFanIn.end(); itr++) {
-                WRITE << " " << *itr << ", ";
+            for (int k = masterCircuitGraph.fanInStart[i]; k < masterCircuitGraph.fanInStart[i + 1]; k++) {
+                WRITE << " " << masterNodeList[masterCircuitGraph.fanInList[k]].lineNumber << ", ";
             }
             WRITE << endl;
             WRITE << "listFanOut = ";
-            for(itr = masterNodeList[i].listFanOut.begin(); itr != masterNodeList[i].listFanOut.end(); itr++) {
-                WRITE << " " << *itr << ", ";
+            for (int k = masterCircuitGraph.fanOutStart[i]; k < masterCircuitGraph.fanOutStart[i + 1]; k++) {
+                WRITE << " " << masterNodeList[masterCircuitGraph.fanOutList[k]].lineNumber << ", ";
             }
             WRITE << endl << "------------------------------------------------------------" << endl;
             WRITE << endl << endl << endl;
@@ -238,9 +360,12 @@ void ReadCircuit (ifstream &inFile) {
  *  Description:  Fault list file has the format <lineNumber> <faultType> on each line.
  *                This function just parses that file and sets the proper variables
  *                in FaultList object list if fault exists.
+ *
+ *                The file is read with a FileScanner, like the circuit file, and the
+ *                line numbers are looked up in the line number table of the graph.
  * =====================================================================================
  */
-void ReadFaultList (ifstream &inFile) {
+void ReadFaultList (char *inFileName) {
 
     #ifdef DEBUG
         WRITE << "================================================================================" << endl;
@@ -248,37 +373,30 @@ void ReadFaultList (ifstream &inFile) {
         WRITE << "================================================================================" << endl << endl;
     #endif
 
-    int outLineNumber;
-    int outFaultValue;
-    bool invalidLine;
+    FileScanner inFile (inFileName);
+    unsigned int outLineNumber;
+    unsigned int outFaultValue;
 
-    while (true) {
-        inFile >> outLineNumber;
-        if (inFile.eof())
-            break;
-        inFile >> outFaultValue;
-        invalidLine = true;
-        for (int i = 0; i < masterNodeList.size(); i++) {
-            if (masterNodeList[i].lineNumber == outLineNumber) {
-                FaultList *thisFault;
-                thisFault = new FaultList (outLineNumber, outFaultValue);
-                providedFaultList.push_back (*thisFault);
-                delete thisFault;
-                invalidLine = false;
-            }
-            // If the line number cannot be found in the circuit then print
-            // a message that it is invalid.
-            //
-            // Continue to the next fault in the file.
-            // This is not an error. The ATPG will simply ignore that invalid line.
-            else {
-                if (i == (masterNodeList.size() - 1) && invalidLine) {
-                    cout << "------------------------------------------------------------" << endl;
-                    cout << "INFO: Invalid line number in the provided fault list." << endl;
-                    cout << "The line number " << outLineNumber << " does not exist in this circuit." << endl;
-                    cout << "------------------------------------------------------------" << endl << endl;
-                }
-            }
+    while (inFile.NextRecord()) {
+        outLineNumber = inFile.ReadNumber();
+        outFaultValue = inFile.ReadNumber();
+        if (outFaultValue != 0 && outFaultValue != 1)
+            inFile.Error("The fault must be stuck at 0 or 1.");
+        inFile.EndRecord();
+
+        if (masterCircuitGraph.FindNode(outLineNumber) >= 0) {
+            providedFaultList.push_back (FaultList (outLineNumber, outFaultValue));
+        }
+        // If the line number cannot be found in the circuit then print
+        // a message that it is invalid.
+        //
+        // Continue to the next fault in the file.
+        // This is not an error. The ATPG will simply ignore that invalid line.
+        else {
+            cout << "------------------------------------------------------------" << endl;
+            cout << "INFO: Invalid line number in the provided fault list." << endl;
+            cout << "The line number " << outLineNumber << " does not exist in this circuit." << endl;
+            cout << "------------------------------------------------------------" << endl << endl;
         }
     }
 
@@ -295,6 +413,47 @@ void ReadFaultList (ifstream &inFile) {
     }
 }
 
+/*
+ * ===  FUNCTION  ======================================================================
+ *         Name:  ReadVectorFile
+ *  Description:  Reads the test vectors to be graded. Every line that has exactly one
+ *                character (0, 1 or X) per primary input is taken as a vector, so the
+ *                vector file written by this program can be read back directly. All
+ *                other lines are ignored.
+ * =====================================================================================
+ */
+void ReadVectorFile (ifstream &inFile, vector <string> &inVectorList) {
+
+    #ifdef DEBUG
+        WRITE << "================================================================================" << endl;
+        WRITE << "===============               In --> ReadVectorFile              ===============" << endl;
+        WRITE << "================================================================================" << endl << endl;
+    #endif
+
+    string thisLine;
+
+    while (getline(inFile, thisLine)) {
+        if (!thisLine.empty() && thisLine[thisLine.length() - 1] == '\r')
+            thisLine.erase(thisLine.length() - 1);
+        if (thisLine.length() != CircuitNode::totalInputs)
+            continue;
+        if (thisLine.find_first_not_of("01Xx4") != string::npos)
+            continue;
+
+        // The vectors are stored with 4 for X, since we are using #define X 4.
+        for (int i = 0; i < thisLine.length(); i++) {
+            if (thisLine[i] == 'X' || thisLine[i] == 'x')
+                thisLine[i] = '4';
+        }
+        inVectorList.push_back(thisLine);
+    }
+
+    #ifdef DEBUG
+        WRITE << "Number of vectors read = " << inVectorList.size() << endl;
+        WRITE << "------------------------------------------------------------" << endl << endl;
+    #endif
+}
+
 /*
  * ============================================================================
  * Functions to Perform Logical Operations on the Circuit.
@@ -307,6 +466,10 @@ void ReadFaultList (ifstream &inFile) {
  *  Description:  This function divides the circuit in logical levels.
  *                There is no feedback in a combinational circuit so we can go from
  *                level 0 to level MAX and find the proper input to output paths.
+ *                If there is feedback, the loop is reported and the program exits.
+ *
+ *                The SCOAP controllability and observability of every line are
+ *                computed here too, over the levelized circuit.
  * =====================================================================================
  */
 void SetLineLevel (vector <CircuitNode> &masterNodeList) {
@@ -317,41 +480,18 @@ void SetLineLevel (vector <CircuitNode> &masterNodeList) {
         WRITE << "================================================================================" << endl << endl;
     #endif
 
-    for (int i = 0; i < masterNodeList.size(); i++) {
-        if (masterNodeList[i].numberFanIn == 0)
-            masterNodeList[i].lineLevel = 0;                    // Level of primary inputs is 0.
-        else
-            masterNodeList[i].lineLevel = -1;                   // Level of all other nodes is -1, placeholder.
-    }
-
-    set <int>::iterator it;
-
-    /*
-     * For all nodes.
-     *      -- For all nodes after the current node.
-     *          -- If the input list of next node contains current node.
-     *              -- Check the level of that next node.
-     *                  -- If it is less than the level of current node, update it.
-     */
-    for (int i = 0; i < masterNodeList.size(); i++) {
-        for (int j = (i + 1); j < masterNodeList.size(); j++) {
-            for (it = masterNodeList[j].listFanIn.begin(); it != masterNodeList[j].listFanIn.end(); it++) {
-                for (int k = 0; k < masterNodeList.size(); k++) {
-                    if (masterNodeList[k].lineNumber == *it) {
-                        if (masterNodeList[k].lineNumber == masterNodeList[i].lineNumber) {
-                            if (masterNodeList[j].lineLevel < (masterNodeList[i].lineLevel + 1)) {
-                                masterNodeList[j].lineLevel = (masterNodeList[i].lineLevel + 1);
-                            }
-                        }
-                    }
-                }
-            }
-        }
+    // Level of primary inputs is 0, every other node is one level above its
+    // highest input. The nodes are also sorted by level, the later passes use
+    // that order. Please refer to CircuitGraph.cc for details.
+    masterCircuitGraph.Levelize(masterNodeList);
+    masterCircuitGraph.ComputeTestability(masterNodeList);
 
     #ifdef DEBUG
-        WRITE << "Line Number = " << masterNodeList[i].lineNumber << ". Level = " << masterNodeList[i].lineLevel << "." << endl;
+        for (int i = 0; i < masterNodeList.size(); i++) {
+            WRITE << "Line Number = " << masterNodeList[i].lineNumber << ". Level = " << masterNodeList[i].lineLevel
+                  << ". CC0 = " << masterNodeList[i].cc0 << ", CC1 = " << masterNodeList[i].cc1 << ", CO = " << masterNodeList[i].co << "." << endl;
+        }
     #endif
-    }
     #ifdef DEBUG
         WRITE << "--------------------------------------------------------------------------------" << endl << endl;
     #endif
@@ -379,32 +519,10 @@ void CreateFaultObjects (map <int, CircuitLine> &masterLineList, vector <Circuit
         WRITE << "================================================================================" << endl << endl;
     #endif
 
-    set <int>::iterator itr;
-
+    // Every fan in and fan out of a node is also a node, so creating an
+    // object for every node covers all the lines in the circuit.
     for (int i = 0; i < masterNodeList.size(); i++) {
-
-        // Create an object for every node.
-        CircuitLine *thisLine;
-        thisLine = new CircuitLine(masterNodeList[i].lineNumber);
-        masterLineList.insert(pair<int, CircuitLine>(masterNodeList[i].lineNumber, *thisLine));
-        delete thisLine;
-
-        // Create an object for every fan in of the node.
-        for (itr = masterNodeList[i].listFanIn.begin(); itr != masterNodeList[i].listFanIn.end(); itr++) {
-            CircuitLine *thisLine;
-            thisLine = new CircuitLine(*itr);
-            masterLineList.insert(pair<int, CircuitLine>(*itr, *thisLine));
-            delete thisLine;
-        }
-
-        // Create an object for every fan out of the node.
-        for (itr = masterNodeList[i].listFanOut.begin(); itr != masterNodeList[i].listFanOut.end(); itr++) {
-            CircuitLine *thisLine;
-            thisLine = new CircuitLine(*itr);
-            masterLineList.insert(pair<int, CircuitLine>(*itr, *thisLine));
-            delete thisLine;
-        }
-
+        masterLineList.insert(pair<int, CircuitLine>(masterNodeList[i].lineNumber, CircuitLine(masterNodeList[i].lineNumber)));
     }
 
     #ifdef DEBUG
@@ -426,9 +544,10 @@ void CreateFaultObjects (map <int, CircuitLine> &masterLineList, vector <Circuit
  * ===  FUNCTION  ======================================================================
  *         Name:  CollapseFaults
  *  Description:  This function takes the list of lines in the circuit and then
- *                collapses the faults going from output to input.
- *
- *                Fault collapse for XOR, XNOR and Branches is not yet implemented.
+ *                collapses the faults. The faults are grouped in equivalence classes
+ *                (see FaultClasses) and only the representative of every class is
+ *                kept as a fault on its line. With the -c option the classes that
+ *                dominate other faults are removed too.
  * =====================================================================================
  */
 void CollapseFaults (map <int, CircuitLine> &masterLineList, vector <CircuitNode> &masterNodeList) {
@@ -439,87 +558,22 @@ void CollapseFaults (map <int, CircuitLine> &masterLineList, vector <CircuitNode
         WRITE << "================================================================================" << endl << endl;
     #endif
 
-    map <int, CircuitLine>::iterator itrMap;
-    set <int>::iterator itrSet;
-    itrMap = masterLineList.end();
-    itrMap--;
+    // A circuit from the cache already has its classes.
+    if (!isCircuitLoaded)
+        masterFaultClasses.Build(masterNodeList, masterCircuitGraph, isDominanceCollapsing);
 
-    int lastOutputLineNumber = (*itrMap).second.lineNumber;         // Line number of the last output.
-    int lastOutputLineLevel = masterNodeList.back().lineLevel;      // Level of the last output.
+    for (int i = 0; i < masterNodeList.size(); i++) {
+        CircuitLine &thisLine = masterLineList.at(masterNodeList[i].lineNumber);
+        thisLine.isStuckAt_0 = masterFaultClasses.IsTarget(FaultClasses::FaultNumber(i, false));
+        thisLine.isStuckAt_1 = masterFaultClasses.IsTarget(FaultClasses::FaultNumber(i, true));
+    }
 
     #ifdef DEBUG
-        WRITE << "Line number of last output = " << lastOutputLineNumber << endl;
-        WRITE << "Level of last output = " << lastOutputLineLevel << endl;
+        WRITE << "Total faults = " << 2 * masterNodeList.size() << endl;
+        WRITE << "Equivalence classes = " << masterFaultClasses.numberClasses << endl;
+        WRITE << "Classes to target = " << masterFaultClasses.numberTargets << endl << endl;
     #endif
 
-    // From the highest level (last output) to zero.
-    //      -- For all the nodes.
-    //          -- If the current node has the highest level.
-    //              -- Collapse faults.
-    //              -- Reduce highest level by 1.
-    //      -- Next iteration of the loop.
-    //
-    // In the collapse faults procedure, the fault can collapse
-    // to any one of the 2/3 inputs.
-    // In this code, the fault always collapses to the input with
-    // the smallest line number.
-    //
-    // Generic structure of the fault collapse is -
-    //      -- Remove both faults from output.
-    //      -- Reduce one of them to single fault at one of the inputs.
-    //      -- Second fault stays on all inputs.
-    //
-    // XOR, XNOR and Branches are not considered here.
-    for (int i = lastOutputLineLevel; i > 0; i--) {
-        for (int j = 0; j < masterNodeList.size(); j++) {
-            if (masterNodeList[j].lineLevel == i) {
-                switch (masterNodeList[j].gateType) {
-                    case G_PI:
-                        break;
-                    case G_BRNCH:
-                        break;
-                    case G_XOR:
-                        break;
-                    case G_OR:
-                    case G_NOR:
-                        for (itrSet = masterNodeList[j].listFanOut.begin(); itrSet != masterNodeList[j].listFanOut.end(); itrSet++) {
-                            masterLineList.at(*itrSet).isStuckAt_0 = false;
-                            masterLineList.at(*itrSet).isStuckAt_1 = false;
-                        }
-                        for (itrSet = masterNodeList[j].listFanIn.begin(); itrSet != masterNodeList[j].listFanIn.end(); itrSet++) {
-                            if (itrSet != masterNodeList[j].listFanIn.begin())
-                                masterLineList.at(*itrSet).isStuckAt_1 = false;
-
-                        }
-                        break;
-                    case G_NOT:
-                        for (itrSet = masterNodeList[j].listFanOut.begin(); itrSet != masterNodeList[j].listFanOut.end(); itrSet++) {
-                            masterLineList.at(*itrSet).isStuckAt_0 = false;
-                            masterLineList.at(*itrSet).isStuckAt_1 = false;
-                        }
-                        break;
-                    case G_NAND:
-                    case G_AND:
-                        for (itrSet = masterNodeList[j].listFanOut.begin(); itrSet != masterNodeList[j].listFanOut.end(); itrSet++) {
-                            masterLineList.at(*itrSet).isStuckAt_0 = false;
-                            masterLineList.at(*itrSet).isStuckAt_1 = false;
-                        }
-                        for (itrSet = masterNodeList[j].listFanIn.begin(); itrSet != masterNodeList[j].listFanIn.end(); itrSet++) {
-                            if (itrSet != masterNodeList[j].listFanIn.begin())
-                                masterLineList.at(*itrSet).isStuckAt_0 = false;
-
-                        }
-                        break;
-                    default:
-                        cerr << "Unknown gate type encountered. The possible gate type values are from 0-7." << endl;
-                        cerr << "Current gate type is " << masterNodeList[j].gateType << endl;
-                        exit (0);
-                        break;
-                }
-            }
-        }
-    }
-
     #ifdef DEBUG
         for (map<int, CircuitLine>::iterator itr = masterLineList.begin(); itr != masterLineList.end(); itr++) {
             WRITE << "------------------------------------------------------------" << endl;
@@ -595,11 +649,8 @@ void SimpleLogicSimulation (int totalInputs, string inVector) {
         WRITE << "================================================================================" << endl << endl;
     #endif
 
-    int *inputVector;
-    inputVector = new int [totalInputs];
-    set <int> *gateVector;
-    gateVector = new set <int> [3];
-    set <int>::iterator itrSet;
+    vector <int> inputVector (totalInputs);
+    vector <unsigned char> lineValues (masterNodeList.size(), V_X);
 
     // Convert the input vector string to integer
     // values to be applied to the circuit for simulation.
@@ -608,55 +659,24 @@ void SimpleLogicSimulation (int totalInputs, string inVector) {
         inputVector[i] = inVector[i] - 48;
     }
 
-    // Clear all the sets. This is important since we don't want
-    // the previous values affecting current simulation.
-    for (int i = 0, j = 0; i < masterNodeList.size(); i++) {
-        masterNodeList[i].lineValue.clear();
+    // Assign the vector to inputs and keep all other values unknown. This is
+    // important since we don't want the previous values affecting current simulation.
+    for (int i = 0; i < masterCircuitGraph.inputNodes.size(); i++) {
+        lineValues[masterCircuitGraph.inputNodes[i]] = PACKTABLE[inputVector[i]];
     }
 
-    // Assign the vector to inputs and keep all other values empty.
-    for (int i = 0, j = 0; i < masterNodeList.size(); i++) {
-        if (masterNodeList[i].numberFanIn == 0)
-            masterNodeList[i].lineValue.insert(inputVector[j++]);
-    }
-
-
-    // Calls implication on all the nodes going from input to output.
-    // Implication would result in a set of single value at the output.
+    // Calls implication on all the nodes going from input to output, level by level.
     // If there is a fault (will be considered in FaultSimulation) then
-    // the output set will have multiple values and/or D and/or B (Dbar).
-    for (int i = 0; i < masterNodeList.size(); i++) {                       // For all nodes.
-        if (masterNodeList[i].numberFanIn != 0) {                           // Not a primary input.
-            int inputNumber = 0;
-
-            // If not a primary input then generate the input set to be given to implication function.
-            for (itrSet = masterNodeList[i].listFanIn.begin(); itrSet != masterNodeList[i].listFanIn.end(); itrSet++) {
-                for (int j = 0; j < masterNodeList.size(); j++) {
-                    if (masterNodeList[j].lineNumber == *itrSet) {
-                        gateVector[inputNumber++] = masterNodeList[j].lineValue;
-                    }
-                }
-            }
-
-            // Call proper implication function depending on the number of the inputs to the gate.
-            // Overloaded function, please refer to logic_implication.cc for details.
-            switch (masterNodeList[i].numberFanIn) {
-                case 1:
-                    masterNodeList[i].lineValue = forwardImplication (masterNodeList[i].gateType, gateVector[0]);
-                    break;
-                case 2:
-                    masterNodeList[i].lineValue = forwardImplication (masterNodeList[i].gateType, gateVector[0], gateVector[1]);
-                    break;
-                case 3:
-                    masterNodeList[i].lineValue = forwardImplication (masterNodeList[i].gateType, gateVector[0], gateVector[1], gateVector[2]);
-                    break;
-                default:
-                    cerr << "This ATPG generator only works if the number of inputs to a gate is less than 4." << endl;
-                    cerr << "Currently there are " << masterNodeList[i].numberFanIn << " inputs to the gate." << endl;
-                    exit (0);
-                    break;
-            }
-        }
+    // the output may have D and/or B (Dbar).
+    // Please refer to forward_implication.cc for details.
+    for (int l = 0; l < masterCircuitGraph.levelOrder.size(); l++) {
+        int i = masterCircuitGraph.levelOrder[l];
+        int firstFanIn = masterCircuitGraph.fanInStart[i];
+        int numberFanIn = masterCircuitGraph.fanInStart[i + 1] - firstFanIn;
+        if (numberFanIn != 0)                                               // Not a primary input.
+            lineValues[i] = forwardImplication (masterNodeList[i].gateType, &lineValues[0],
+                                                &masterCircuitGraph.fanInList[firstFanIn], numberFanIn);
+        masterNodeList[i].lineValue = lineValues[i];
     }
 
     #ifdef DEBUG
@@ -670,10 +690,7 @@ void SimpleLogicSimulation (int totalInputs, string inVector) {
         for (int i = 0; i < masterNodeList.size(); i++) {
             if (masterNodeList[i].numberFanIn == 0) {
                 WRITE << "The value of the input at line number " << masterNodeList[i].lineNumber << " is = ";
-                for (itrSet = masterNodeList[i].lineValue.begin(); itrSet != masterNodeList[i].lineValue.end(); itrSet++) {
-                    WRITE << *itrSet << " ";
-                }
-                WRITE << endl;
+                WRITE << UNPACKTABLE[masterNodeList[i].lineValue] << endl;
             }
         }
         WRITE << endl;
@@ -681,10 +698,7 @@ void SimpleLogicSimulation (int totalInputs, string inVector) {
         for (int i = 0; i < masterNodeList.size(); i++) {
             if (masterNodeList[i].numberFanIn != 0) {
                 WRITE << "The value of the line number " << masterNodeList[i].lineNumber << " is = ";
-                for (itrSet = masterNodeList[i].lineValue.begin(); itrSet != masterNodeList[i].lineValue.end(); itrSet++) {
-                    WRITE << *itrSet << " ";
-                }
-                WRITE << endl;
+                WRITE << UNPACKTABLE[masterNodeList[i].lineValue] << endl;
             }
         }
         WRITE << endl;
@@ -692,10 +706,7 @@ void SimpleLogicSimulation (int totalInputs, string inVector) {
         for (int i = 0; i < masterNodeList.size(); i++) {
             if (masterNodeList[i].numberFanOut == 0) {
                 WRITE << "The value of the output at line number " << masterNodeList[i].lineNumber << " is = ";
-                for (itrSet = masterNodeList[i].lineValue.begin(); itrSet != masterNodeList[i].lineValue.end(); itrSet++) {
-                    WRITE << *itrSet << " ";
-                }
-                WRITE << endl;
+                WRITE << UNPACKTABLE[masterNodeList[i].lineValue] << endl;
             }
         }
 
@@ -705,351 +716,804 @@ void SimpleLogicSimulation (int totalInputs, string inVector) {
 
 /*
  * ===  FUNCTION  ======================================================================
- *         Name:  GenerateMasterInputVectors
- *  Description:  This function takes in the number of inputs and then generates an
- *                exhaustive list of vectors to test the circuit with. Starting with
- *                all 'X's and finishing with all known inputs.
+ *         Name:  CheckAllFaultsATPG
+ *  Description:  This function checks which of the given vectors can test each of the
+ *                faults in the fault list. The first vector in the list that detects
+ *                the fault is added to the TestList object for that fault. If no
+ *                vector detects the fault then the test possible flag in the TestList
+ *                object is set to false.
  *
- *                These vectors are later tested with the circuit to check if a fault
- *                can be detected.
+ *                The vectors are simulated a block at a time by the FaultSimulator, and a
+ *                fault is not simulated again once a vector detects it. With more
+ *                than one thread the faults are split between the threads.
+ *
+ *                With the -s option the ConcurrentSimulator is used instead. It takes
+ *                the vectors one at a time, on one thread, and gives the same results.
  * =====================================================================================
  */
-void GenerateMasterInputVectors (int totalInputs) {
+void CheckAllFaultsATPG (vector <string> &inVectorList, vector <TestList> &inTestList, vector <FaultList> &inFaultList) {
 
     #ifdef DEBUG
         WRITE << "================================================================================" << endl;
-        WRITE << "===============        In --> GenerateMasterInputVectors         ===============" << endl;
+        WRITE << "===============            In --> CheckAllFaultsATPG             ===============" << endl;
         WRITE << "================================================================================" << endl << endl;
     #endif
 
-    string resultVector;                                    // Input vector.
-    vector <string> *tempInputVector;                       // We have to sort vectors by number of X in them.
-    tempInputVector = new vector <string> [totalInputs];
-    vector <string>::iterator itrVector;
-
-    for (int i = 0; i < (pow(3, totalInputs) - 1); i++) {   // Go on converting numbers in base 3 system.
-        resultVector = RadixConvert (i, 3);
-        int numberOfX = 0;                                  // Total X in the vector.
-        int positionOfX = resultVector.find_first_of('2');  // Iterate over the vector.
-        while (positionOfX!=string::npos)
-        {
-            numberOfX++;                                    // Count number of 'X's
-            resultVector[positionOfX] = '4';                // Replace 2 by 4 since we are using #define X 4.
-            positionOfX = resultVector.find_first_of('2',(positionOfX + 1));
-        }
+    vector <int> detectingVector;
+
+    if (isConcurrentSimulation) {
+        ConcurrentSimulator concurrentSimulator (masterNodeList, masterCircuitGraph);
+        concurrentSimulator.GradeVectors(inVectorList, inFaultList, detectingVector);
+
+        #ifdef DEBUG
+            WRITE << "Vectors simulated = " << concurrentSimulator.totalVectors << endl;
+            WRITE << "Fault list entries = " << concurrentSimulator.totalEntries << endl;
+            WRITE << endl;
+        #endif
+    } else {
+        AtpgWorkers atpgWorkers (masterNodeList, masterCircuitGraph, numberThreads);
+        atpgWorkers.isPathTracing = isPathTracing;
+        atpgWorkers.GradeVectors(inVectorList, inFaultList, detectingVector);
 
-        tempInputVector[numberOfX].push_back(resultVector);
+        #ifdef DEBUG
+            atpgWorkers.simulationCounters.Write(WRITE);
+            WRITE << endl;
+        #endif
     }
 
-    // Now we have to put all the vectors in a large table.
-    // There are no leading zeros in the string. We need them
-    // in our simulation so padding is also done.
-    for (int i = 0; i < totalInputs; i++) {
-        for (itrVector = tempInputVector[i].begin(); itrVector != tempInputVector[i].end(); itrVector++) {
-            resultVector = *itrVector;
-            int vectorLength = resultVector.length();
-	        for (int j = 0; j < (totalInputs - vectorLength); j++)
-		        resultVector = "0" + resultVector;
-            masterInputVector.push_back (resultVector);
+    for (int i = 0; i < inFaultList.size(); i++) {
+        if (detectingVector[i] >= 0) {
+            inTestList.push_back(TestList(inFaultList[i].lineNumber, inFaultList[i].stuckAtValue, inVectorList[detectingVector[i]]));
+
+            #ifdef DEBUG
+                WRITE << "------------------------------------------------------------" << endl;
+                WRITE << "The fault is at line number = " << inFaultList[i].lineNumber << endl;
+                WRITE << "The fault is stuck at = " << inFaultList[i].stuckAtValue << endl;
+                WRITE << "Test was generated by vector = " << inVectorList[detectingVector[i]] << endl;
+                WRITE << "------------------------------------------------------------" << endl;
+                WRITE << endl;
+            #endif
+        } else {
+            inTestList.push_back(TestList(inFaultList[i].lineNumber, inFaultList[i].stuckAtValue));
+
+            #ifdef DEBUG
+                WRITE << endl;
+                WRITE << "------------------------------------------------------------" << endl;
+                WRITE << "The fault is at line number = " << inFaultList[i].lineNumber << endl;
+                WRITE << "The fault is stuck at = " << inFaultList[i].stuckAtValue << endl;
+                WRITE << "Test cannot be generated for this fault." << endl;
+                WRITE << "------------------------------------------------------------" << endl;
+                WRITE << endl;
+            #endif
         }
     }
 
-    // We start from the case with most 'X's and go to the case with minimum 'X's.
-    // For this we have to reverse the vector.
-    reverse (masterInputVector.begin(), masterInputVector.end());
+}
+
+/*
+ * ===  FUNCTION  ======================================================================
+ *         Name:  ExhaustiveAllFaultsATPG
+ *  Description:  This function tries the possible input vectors on the circuit, starting
+ *                with the vectors with the most 'X's, until every fault in the fault list
+ *                is detected or all the vectors have been tried.
+ *
+ *                The vectors are made by the VectorEnumerator a block at a time, so the list
+ *                of all 3^n vectors is never stored. Only the vectors that detect a fault
+ *                not detected before are kept, and CheckAllFaultsATPG then builds the
+ *                test list from them. This gives the same tests as checking the faults
+ *                against the full list of vectors.
+ * =====================================================================================
+ */
+void ExhaustiveAllFaultsATPG (vector <TestList> &inTestList, vector <FaultList> &inFaultList) {
 
     #ifdef DEBUG
-    WRITE << "Total Inputs = " << totalInputs << endl;
-    WRITE << "------------------------------------------------------------" << endl << endl;
-    WRITE << "Vector Table for this circuit." << endl;
-    WRITE << "------------------------------------------------------------" << endl << endl;
-    for (itrVector = masterInputVector.begin(); itrVector != masterInputVector.end(); itrVector++) {
-        WRITE << *itrVector << endl;
+        WRITE << "================================================================================" << endl;
+        WRITE << "===============          In --> ExhaustiveAllFaultsATPG          ===============" << endl;
+        WRITE << "================================================================================" << endl << endl;
+    #endif
+
+    FaultSimulator faultSimulator (masterNodeList, masterCircuitGraph);
+    faultSimulator.isPathTracing = isPathTracing;
+    VectorEnumerator vectorEnumerator (CircuitNode::totalInputs);
+    vector <string> thisBlock;
+    vector <string> detectingVectorList;                    // Vectors that detected a new fault.
+    vector <int> remainingFaults;
+    vector <int> detectedFaults;
+    vector <int> detectingVector;
+    string thisVector;
+    unsigned long totalVectors = 0;
+
+    for (int i = 0; i < inFaultList.size(); i++) {
+        remainingFaults.push_back(i);
+    }
+
+    while (!remainingFaults.empty()) {
+        thisBlock.clear();
+        while (thisBlock.size() < faultSimulator.BlockSize() && vectorEnumerator.NextVector(thisVector))
+            thisBlock.push_back(thisVector);
+        if (thisBlock.empty())
+            break;
+        totalVectors += thisBlock.size();
+
+        faultSimulator.SimulateVectors(thisBlock, 0, thisBlock.size(), inFaultList, remainingFaults, detectedFaults, detectingVector);
+
+        // Keep every vector that detected something once, in the order they were made.
+        sort (detectingVector.begin(), detectingVector.end());
+        detectingVector.erase(unique(detectingVector.begin(), detectingVector.end()), detectingVector.end());
+        for (int i = 0; i < detectingVector.size(); i++) {
+            detectingVectorList.push_back(thisBlock[detectingVector[i]]);
+        }
     }
-    WRITE << "------------------------------------------------------------" << endl << endl;
+
+    #ifdef DEBUG
+        WRITE << "Total vectors simulated = " << totalVectors << endl;
+        WRITE << "Vectors that detect a new fault = " << detectingVectorList.size() << endl;
+        faultSimulator.counters.Write(WRITE);
+        WRITE << endl;
     #endif
+
+    CheckAllFaultsATPG(detectingVectorList, inTestList, inFaultList);
 }
 
 /*
  * ===  FUNCTION  ======================================================================
- *         Name:  CheckVectorForATPG
- *  Description:  This function takes in the line number and the fault present at that
- *                line. It also takes in an input vector to be checked.
+ *         Name:  RandomPatternATPG
+ *  Description:  This function tries pseudo random vectors on the faults in the fault
+ *                list before the test generation. The vectors are fault simulated a
+ *                block of RANDOM_BLOCK_VECTORS at a time, and a fault that is detected
+ *                is added to the test list with the first vector that detects it.
+ *                Vectors that detect no new fault are thrown away.
  *
- *                It then checks first if the fault can be excited. If the fault can be
- *                excited then it checks whether the fault can be propagated to any one
- *                of the outputs. If both of them result in true then the fault can be
- *                tested with the vector.
+ *                The phase stops when a block detects less than randomMinimumGain
+ *                percent of the faults, after RANDOM_MAX_BLOCKS blocks, or when every
+ *                fault is detected. The faults that are left are written to
+ *                outHardFaults, for the deterministic search.
  * =====================================================================================
  */
-bool CheckVectorForATPG (int totalInputs, int inLineNumber, bool inStuckAtValue, string inVector) {
+void RandomPatternATPG (vector <TestList> &inTestList, vector <FaultList> &inFaultList, vector <FaultList> &outHardFaults) {
 
-    int *inputVector;
-    inputVector = new int [totalInputs];
-    set <int> *gateVector;
-    gateVector = new set <int> [3];
-    set <int>::iterator itrSet;
+    #ifdef DEBUG
+        WRITE << "================================================================================" << endl;
+        WRITE << "===============             In --> RandomPatternATPG             ===============" << endl;
+        WRITE << "================================================================================" << endl << endl;
+    #endif
 
-    // Convert the input vector string to integer
-    // values to be applied to the circuit for simulation.
-    // (- 48) is done to convert ascii to integer.
-    for (int i = 0; i < totalInputs; i++) {
-        inputVector[i] = inVector[i] - 48;
+    FaultSimulator faultSimulator (masterNodeList, masterCircuitGraph);
+    faultSimulator.isPathTracing = isPathTracing;
+    PatternGenerator patternGenerator (CircuitNode::totalInputs, randomSeed);
+    vector <string> blockVectors (RANDOM_BLOCK_VECTORS);
+    vector <int> remainingFaults;
+    vector <int> detectedFaults;
+    vector <int> detectingVector;
+    vector <bool> isKept (RANDOM_BLOCK_VECTORS);
+    int numberBlocks = 0;
+    int numberKept = 0;
+
+    for (int i = 0; i < inFaultList.size(); i++) {
+        remainingFaults.push_back(i);
     }
 
-    // Clear all the sets. This is important since we don't want
-    // the previous values affecting current simulation.
-    for (int i = 0; i < masterNodeList.size(); i++) {
-        masterNodeList[i].lineValue.clear();
+    while (numberBlocks < RANDOM_MAX_BLOCKS && !remainingFaults.empty()) {
+        int numberDetected = 0;
+        for (int k = 0; k < RANDOM_BLOCK_VECTORS; k++) {
+            patternGenerator.NextVector(blockVectors[k]);
+            isKept[k] = false;
+        }
+        numberBlocks++;
+
+        for (int first = 0; first < RANDOM_BLOCK_VECTORS && !remainingFaults.empty(); first += faultSimulator.BlockSize()) {
+            int count = RANDOM_BLOCK_VECTORS - first;
+            if (count > faultSimulator.BlockSize())
+                count = faultSimulator.BlockSize();
+
+            faultSimulator.SimulateVectors(blockVectors, first, count, inFaultList, remainingFaults, detectedFaults, detectingVector);
+            for (int i = 0; i < detectedFaults.size(); i++) {
+                FaultList &thisFault = inFaultList[detectedFaults[i]];
+                inTestList.push_back(TestList(thisFault.lineNumber, thisFault.stuckAtValue, blockVectors[detectingVector[i]]));
+                isKept[detectingVector[i]] = true;
+            }
+            numberDetected += detectedFaults.size();
+        }
+
+        for (int k = 0; k < RANDOM_BLOCK_VECTORS; k++) {
+            if (isKept[k])
+                numberKept++;
+        }
+
+        #ifdef DEBUG
+            WRITE << "Random block " << numberBlocks << ", faults detected = " << numberDetected
+                  << ", faults left = " << remainingFaults.size() << endl;
+        #endif
+
+        if (100.0 * numberDetected < randomMinimumGain * inFaultList.size())
+            break;
     }
 
-    // Assign the vector to inputs and keep all other values empty.
-    for (int i = 0, j = 0; i < masterNodeList.size(); i++) {
-        if (masterNodeList[i].numberFanIn == 0)
-            masterNodeList[i].lineValue.insert(inputVector[j++]);
+    outHardFaults.clear();
+    for (int i = 0; i < remainingFaults.size(); i++) {
+        outHardFaults.push_back(inFaultList[remainingFaults[i]]);
     }
 
-    bool isFaultExcited = false;        // Check if the fault can be excited.
-    bool isTestGenerated = false;       // Check if the test is generated.
+    cout << "Random patterns: " << (inFaultList.size() - outHardFaults.size()) << " of " << inFaultList.size()
+         << " faults detected by " << numberKept << " of " << numberBlocks * RANDOM_BLOCK_VECTORS << " patterns" << endl;
 
-    // For all the nodes in the circuit.
-    //      -- For all the primary inputs.
-    //          -- If the current line == the line where fault exists.
-    //              -- If the fault can be excited.
-    //                  -- Set the value to D or Dbar.
-    for (int i = 0; i < masterNodeList.size(); i++) {
-        if (masterNodeList[i].numberFanIn == 0) {
-            if (inLineNumber == masterNodeList[i].lineNumber) {
-                for (itrSet = masterNodeList[i].lineValue.begin(); itrSet != masterNodeList[i].lineValue.end(); itrSet++) {
-                    if (*itrSet == 0 && inStuckAtValue == true) {
-                        isFaultExcited = true;
-                        masterNodeList[i].lineValue.clear();
-                        masterNodeList[i].lineValue.insert(3);
-                        break;
-                    }
-                    if (*itrSet == 1 && inStuckAtValue == false) {
-                        isFaultExcited = true;
-                        masterNodeList[i].lineValue.clear();
-                        masterNodeList[i].lineValue.insert(2);
-                        break;
-                    }
-                }
-            }
+    #ifdef DEBUG
+        WRITE << endl;
+        WRITE << "Random patterns simulated = " << numberBlocks * RANDOM_BLOCK_VECTORS << endl;
+        WRITE << "Random patterns kept = " << numberKept << endl;
+        WRITE << "Faults left for the search = " << outHardFaults.size() << endl;
+        faultSimulator.counters.Write(WRITE);
+        WRITE << "------------------------------------------------------------" << endl << endl;
+    #endif
+}
+
+/*
+ * ===  FUNCTION  ======================================================================
+ *         Name:  OrderFaults
+ *  Description:  Sorts the faults by how hard they are to test, easiest first for
+ *                ORDER_EASY and hardest first for ORDER_HARD. A fault costs the SCOAP
+ *                controllability of the opposite of its stuck at value plus the
+ *                observability of its line. Faults with the same cost stay in the
+ *                order of the list.
+ * =====================================================================================
+ */
+void OrderFaults (vector <FaultList> &ioFaultList, int inOrder) {
+
+    vector < pair <unsigned int, int> > faultCost;
+    vector <FaultList> sortedFaults;
+
+    for (int i = 0; i < ioFaultList.size(); i++) {
+        int thisNode = masterCircuitGraph.FindNode(ioFaultList[i].lineNumber);
+        unsigned int thisCost = SCOAP_LIMIT;
+        if (thisNode >= 0) {
+            CircuitNode &faultNode = masterNodeList[thisNode];
+            thisCost = (ioFaultList[i].stuckAtValue ? faultNode.cc0 : faultNode.cc1) + faultNode.co;
         }
+        if (inOrder == ORDER_HARD)
+            thisCost = 2 * SCOAP_LIMIT - thisCost;
+        faultCost.push_back(make_pair(thisCost, i));
     }
+    sort(faultCost.begin(), faultCost.end());
 
-    set <int> tempSet;  // To store the result of implication.
+    for (int i = 0; i < faultCost.size(); i++) {
+        sortedFaults.push_back(ioFaultList[faultCost[i].second]);
+    }
+    ioFaultList.swap(sortedFaults);
+}
 
-    // Calls implication on all the nodes going from input to output.
-    // Implication would result in a set of single value at the output.
-    // If there is a fault (will be considered in FaultSimulation) then
-    // the output set will have multiple values and/or D and/or B (Dbar).
-    for (int i = 0; i < masterNodeList.size(); i++) {                       // For all nodes.
-        if (masterNodeList[i].numberFanIn != 0) {                           // Not a primary input.
-            int inputNumber = 0;
-
-            // If not a primary input then generate the input set to be given to implication function.
-            for (itrSet = masterNodeList[i].listFanIn.begin(); itrSet != masterNodeList[i].listFanIn.end(); itrSet++) {
-                for (int j = 0; j < masterNodeList.size(); j++) {
-                    if (masterNodeList[j].lineNumber == *itrSet) {
-                        gateVector[inputNumber++] = masterNodeList[j].lineValue;
-                    }
-                }
-            }
+/*
+ * ===  FUNCTION  ======================================================================
+ *         Name:  DropAbortedFaults
+ *  Description:  Grades the tests found so far (the faults in FAULT_DETECTED) against
+ *                the aborted faults in ioAbortedFaults. A fault that one of them
+ *                detects is dropped with that test and taken out of ioAbortedFaults.
+ * =====================================================================================
+ */
+void DropAbortedFaults (AtpgWorkers &inWorkers, vector <FaultList> &inFaultList, vector <int> &ioFaultStatus,
+                        vector <string> &ioTestVector, vector <int> &ioAbortedFaults) {
 
-            // Call proper implication function depending on the number of the inputs to the gate.
-            // Overloaded function, please refer to logic_implication.cc for details.
-            switch (masterNodeList[i].numberFanIn) {
-                case 1:
-                    tempSet = forwardImplication (masterNodeList[i].gateType, gateVector[0]);
-                    break;
-                case 2:
-                    tempSet = forwardImplication (masterNodeList[i].gateType, gateVector[0], gateVector[1]);
-                    break;
-                case 3:
-                    tempSet = forwardImplication (masterNodeList[i].gateType, gateVector[0], gateVector[1], gateVector[2]);
-                    break;
-                default:
-                    cerr << "This ATPG generator only works if the number of inputs to a gate is less than 4." << endl;
-                    cerr << "Currently there are " << masterNodeList[i].numberFanIn << " inputs to the gate." << endl;
-                    exit (0);
-                    break;
-            }
-            // If the current line number is the same as the line number with the fault.
-            //      -- If the fault can be excited.
-            //          -- Set proper value D or Dbar.
-            if (inLineNumber == masterNodeList[i].lineNumber) {
-                for (itrSet = tempSet.begin(); itrSet != tempSet.end(); itrSet++) {
-                    if (*itrSet == 0 && inStuckAtValue == true) {
-                        isFaultExcited = true;
-                        tempSet.clear();
-                        tempSet.insert(3);
-                        break;
-                    }
-                    if (*itrSet == 1 && inStuckAtValue == false) {
-                        isFaultExcited = true;
-                        tempSet.clear();
-                        tempSet.insert(2);
-                        break;
-                    }
-                }
-                // If fault cannot be excited, exit.
-                if (isFaultExcited == false) {
-                    return false;
-                }
-            }
-            // If fault can be excited, assign the value D or Dbar to the line.
-            masterNodeList[i].lineValue = tempSet;
-        }
+    vector <string> foundTests;
+    vector <FaultList> abortedList;
+    vector <int> detectingVector;
+
+    for (int i = 0; i < inFaultList.size(); i++) {
+        if (ioFaultStatus[i] == FAULT_DETECTED)
+            foundTests.push_back(ioTestVector[i]);
+    }
+    if (foundTests.empty() || ioAbortedFaults.empty())
+        return;
+    for (int k = 0; k < ioAbortedFaults.size(); k++) {
+        abortedList.push_back(inFaultList[ioAbortedFaults[k]]);
     }
 
-    // Once the simulation is done, check all the outputs.
-    //      -- If any output has either a D or a Dbar then the fault is detected.
-    //      -- The vector can test the fault.
-    for (int i = 0; i < masterNodeList.size(); i++) {
-        if (masterNodeList[i].numberFanOut == 0) {
-            for (itrSet = masterNodeList[i].lineValue.begin(); itrSet != masterNodeList[i].lineValue.end(); itrSet++) {
-                if (*itrSet == 2 || *itrSet == 3) {
-                    isTestGenerated = true;
-                }
-            }
+    inWorkers.GradeVectors(foundTests, abortedList, detectingVector);
+    int numberLeft = 0;
+    for (int k = 0; k < ioAbortedFaults.size(); k++) {
+        if (detectingVector[k] >= 0) {
+            ioFaultStatus[ioAbortedFaults[k]] = FAULT_DROPPED;
+            ioTestVector[ioAbortedFaults[k]] = foundTests[detectingVector[k]];
         }
+        else
+            ioAbortedFaults[numberLeft++] = ioAbortedFaults[k];
     }
+    ioAbortedFaults.resize(numberLeft);
+}
+
+/*
+ * ===  FUNCTION  ======================================================================
+ *         Name:  PodemAllFaultsATPG
+ *  Description:  This function generates a test for every fault in the fault list
+ *                using PODEM. Unlike CheckAllFaultsATPG it does not need a list of
+ *                input vectors, the inputs are assigned one at a time by the search.
+ *
+ *                The results are added to the test list in the same way, with the
+ *                test possible flag set to false for redundant and aborted faults.
+ *
+ *                With fault dropping, every new test is simulated against the faults
+ *                later in the list that do not have a test yet. Those faults get the
+ *                same test when their turn comes and are not searched for.
+ *
+ *                The faults are shared between numberThreads worker threads. The test
+ *                list is always in the order of the fault list, after OrderFaults if
+ *                a fault order was given. With more than one thread and fault
+ *                dropping, which faults are searched and which are dropped depends
+ *                on which searches finish first, so the tests, and the faults left
+ *                aborted, can change with numberThreads.
+ *
+ *                The faults aborted by the per fault limits are searched again once
+ *                all the others are done, with limits RETRY_LIMIT_FACTOR times
+ *                higher. With fault dropping the tests found so far are tried on
+ *                them first, and the faults still aborted after the retry are
+ *                tried on its tests too. With the SAT search, the aborted faults go
+ *                to SatAtpg instead, with no limit but the one on the whole run, and
+ *                PODEM gets a limit of SAT_PODEM_BACKTRACKS unless -b was given.
+ * =====================================================================================
+ */
+void PodemAllFaultsATPG (vector <TestList> &inTestList, vector <FaultList> &inFaultList) {
 
     #ifdef DEBUG
-        if (isTestGenerated) {
-            WRITE << "================================================================================" << endl;
-            WRITE << "===============            In --> CheckVectorForATPG             ===============" << endl;
-            WRITE << "================================================================================" << endl << endl;
-            WRITE << "There are " << CircuitNode::totalInputs << " inputs to this circuit." << endl << endl;
-
-            for (int i = 0; i < totalInputs; i++) {
-                WRITE << "Input Vector [" << i << "] is = " << inputVector[i] << endl;
-            }
-            WRITE << endl;
+        WRITE << "================================================================================" << endl;
+        WRITE << "===============            In --> PodemAllFaultsATPG             ===============" << endl;
+        WRITE << "================================================================================" << endl << endl;
+    #endif
 
-            for (int i = 0; i < masterNodeList.size(); i++) {
-                if (masterNodeList[i].numberFanIn == 0) {
-                    WRITE << "The value of the input at line number " << masterNodeList[i].lineNumber << " is = ";
-                    for (itrSet = masterNodeList[i].lineValue.begin(); itrSet != masterNodeList[i].lineValue.end(); itrSet++) {
-                        WRITE << *itrSet << " ";
-                    }
-                    WRITE << endl;
-                }
-            }
-            WRITE << endl;
+    // The test list follows the order the faults were searched in.
+    vector <FaultList> targetFaults (inFaultList);
+    if (faultOrder != ORDER_LIST)
+        OrderFaults(targetFaults, faultOrder);
+
+    AtpgWorkers atpgWorkers (masterNodeList, masterCircuitGraph, numberThreads);
+    atpgWorkers.isPathTracing = isPathTracing;
+    atpgWorkers.isFanSearch = (atpgAlgorithm == ATPG_FAN);
+    atpgWorkers.compactionTargets = compactionTargets;
+    atpgWorkers.backtrackLimit = backtrackLimit;
+    atpgWorkers.timeLimit = faultTimeLimit;
+    atpgWorkers.stopTime = runStopTime;
+    if (isSatFallback && !isBacktrackLimitSet)
+        atpgWorkers.backtrackLimit = SAT_PODEM_BACKTRACKS;
+    if (isStaticLearning)
+        atpgWorkers.staticLearning = &masterStaticLearning;
+    vector <int> faultStatus;
+    vector <string> testVector;
+
+    atpgWorkers.GenerateTests(targetFaults, isFaultDropping, faultStatus, testVector);
+
+    vector <int> abortedFaults;
+    for (int i = 0; i < targetFaults.size(); i++) {
+        if (faultStatus[i] == FAULT_ABORTED)
+            abortedFaults.push_back(i);
+    }
+    int numberFirstAborted = abortedFaults.size();
+
+    if (isFaultDropping)
+        DropAbortedFaults(atpgWorkers, targetFaults, faultStatus, testVector, abortedFaults);
+
+    if (!abortedFaults.empty() && (backtrackLimit > 0 || faultTimeLimit > 0 || isSatFallback) && chrono::steady_clock::now() < runStopTime) {
+        AtpgWorkers retryWorkers (masterNodeList, masterCircuitGraph, numberThreads);
+        retryWorkers.isPathTracing = isPathTracing;
+        retryWorkers.isSatSearch = isSatFallback;
+        retryWorkers.isFanSearch = (atpgAlgorithm == ATPG_FAN);
+        retryWorkers.compactionTargets = compactionTargets;
+        if (isStaticLearning)
+            retryWorkers.staticLearning = &masterStaticLearning;
+        if (!isSatFallback) {
+            retryWorkers.backtrackLimit = backtrackLimit * RETRY_LIMIT_FACTOR;
+            retryWorkers.timeLimit = faultTimeLimit * RETRY_LIMIT_FACTOR;
+        }
+        retryWorkers.stopTime = runStopTime;
+        vector <FaultList> retryFaults;
+        vector <int> retryStatus;
+        vector <string> retryVector;
 
-            for (int i = 0; i < masterNodeList.size(); i++) {
-                if (masterNodeList[i].numberFanIn != 0) {
-                    WRITE << "The value of the line number " << masterNodeList[i].lineNumber << " is = ";
-                    for (itrSet = masterNodeList[i].lineValue.begin(); itrSet != masterNodeList[i].lineValue.end(); itrSet++) {
-                        WRITE << *itrSet << " ";
-                    }
-                    WRITE << endl;
-                }
+        for (int k = 0; k < abortedFaults.size(); k++) {
+            retryFaults.push_back(targetFaults[abortedFaults[k]]);
+        }
+        retryWorkers.GenerateTests(retryFaults, isFaultDropping, retryStatus, retryVector);
+        for (int k = 0; k < abortedFaults.size(); k++) {
+            faultStatus[abortedFaults[k]] = retryStatus[k];
+            testVector[abortedFaults[k]] = retryVector[k];
+        }
+
+        #ifdef DEBUG
+            WRITE << "Retried aborted faults = " << abortedFaults.size() << endl;
+            if (isSatFallback) {
+                WRITE << "Total SAT searches = " << retryWorkers.totalSearches << endl;
+                WRITE << "Total SAT decisions = " << retryWorkers.totalDecisions << endl;
+                WRITE << "Total SAT conflicts = " << retryWorkers.totalBacktracks << endl << endl;
+            } else {
+                WRITE << "Retry PODEM searches = " << retryWorkers.totalSearches << endl;
+                WRITE << "Retry PODEM backtracks = " << retryWorkers.totalBacktracks << endl << endl;
             }
-            WRITE << endl;
+        #endif
 
-            for (int i = 0; i < masterNodeList.size(); i++) {
-                if (masterNodeList[i].numberFanOut == 0) {
-                    WRITE << "The value of the output at line number " << masterNodeList[i].lineNumber << " is = ";
-                    for (itrSet = masterNodeList[i].lineValue.begin(); itrSet != masterNodeList[i].lineValue.end(); itrSet++) {
-                        WRITE << *itrSet << " ";
-                    }
-                    WRITE << endl;
-                }
+        // The faults still aborted may be detected by the tests of the retry.
+        if (isFaultDropping) {
+            int numberLeft = 0;
+            for (int k = 0; k < abortedFaults.size(); k++) {
+                if (faultStatus[abortedFaults[k]] == FAULT_ABORTED)
+                    abortedFaults[numberLeft++] = abortedFaults[k];
             }
+            abortedFaults.resize(numberLeft);
+            DropAbortedFaults(atpgWorkers, targetFaults, faultStatus, testVector, abortedFaults);
+        }
+    }
+
+    int numberAborted = 0;
+    for (int i = 0; i < targetFaults.size(); i++) {
+        if (faultStatus[i] == FAULT_REDUNDANT || faultStatus[i] == FAULT_ABORTED) {
+            inTestList.push_back(TestList(targetFaults[i].lineNumber, targetFaults[i].stuckAtValue));
+            inTestList.back().isAborted = (faultStatus[i] == FAULT_ABORTED);
+            numberAborted += (faultStatus[i] == FAULT_ABORTED);
+
+            #ifdef DEBUG
+                WRITE << "------------------------------------------------------------" << endl;
+                WRITE << "The fault is at line number = " << targetFaults[i].lineNumber << endl;
+                WRITE << "The fault is stuck at = " << targetFaults[i].stuckAtValue << endl;
+                if (faultStatus[i] == FAULT_ABORTED)
+                    WRITE << "Test generation was aborted for this fault." << endl;
+                else
+                    WRITE << "Test cannot be generated for this fault." << endl;
+                WRITE << "------------------------------------------------------------" << endl;
+                WRITE << endl;
+            #endif
+            continue;
+        }
+
+        inTestList.push_back(TestList(targetFaults[i].lineNumber, targetFaults[i].stuckAtValue, testVector[i]));
 
+        #ifdef DEBUG
+            WRITE << "------------------------------------------------------------" << endl;
+            WRITE << "The fault is at line number = " << targetFaults[i].lineNumber << endl;
+            WRITE << "The fault is stuck at = " << targetFaults[i].stuckAtValue << endl;
+            if (faultStatus[i] == FAULT_DROPPED)
+                WRITE << "Fault was dropped, detected by vector = " << testVector[i] << endl;
+            else
+                WRITE << "Test was generated by vector = " << testVector[i] << endl;
+            WRITE << "------------------------------------------------------------" << endl;
             WRITE << endl;
+        #endif
+    }
+
+    #ifdef DEBUG
+        WRITE << "Total faults = " << targetFaults.size() << endl;
+        WRITE << "Total PODEM searches = " << atpgWorkers.totalSearches << endl;
+        WRITE << "Total PODEM decisions = " << atpgWorkers.totalDecisions << endl;
+        WRITE << "Total PODEM backtracks = " << atpgWorkers.totalBacktracks << endl;
+        if (isStaticLearning)
+            WRITE << "PODEM dead ends found by static learning = " << atpgWorkers.totalPrunes << endl;
+        if (compactionTargets > 0) {
+            WRITE << "Faults tried by dynamic compaction = " << atpgWorkers.totalSecondaryTargets << endl;
+            WRITE << "Faults added to tests by dynamic compaction = " << atpgWorkers.totalSecondaryDetected << endl;
+        }
+        WRITE << "Faults aborted in the first pass = " << numberFirstAborted << endl;
+        WRITE << "Faults aborted = " << numberAborted << endl;
+        if (isFaultDropping)
+            atpgWorkers.simulationCounters.Write(WRITE);
+        WRITE << "------------------------------------------------------------" << endl << endl;
+    #endif
+}
+
+/*
+ * ===  FUNCTION  ======================================================================
+ *         Name:  TargetDominatingFaults
+ *  Description:  With dominance collapsing, the dominating classes get no test of their
+ *                own. They are normally detected by the test of the fault they dominate,
+ *                but not if that fault is redundant. So the representatives of these
+ *                classes are graded against the tests in the test list, and a test is
+ *                generated for the ones that are not detected. The results are added to
+ *                the test list.
+ * =====================================================================================
+ */
+void TargetDominatingFaults (vector <TestList> &inTestList) {
+
+    #ifdef DEBUG
+        WRITE << "================================================================================" << endl;
+        WRITE << "===============          In --> TargetDominatingFaults           ===============" << endl;
+        WRITE << "================================================================================" << endl << endl;
+    #endif
+
+    vector <FaultList> dominatingFaults;
+    vector <FaultList> undetectedFaults;
+    vector <string> testVector;
+    vector <int> detectingVector;
+
+    for (int i = 0; i < masterNodeList.size(); i++) {
+        for (int v = 0; v < 2; v++) {
+            int thisFault = FaultClasses::FaultNumber(i, v);
+            if (masterFaultClasses.FindClass(thisFault) == thisFault && !masterFaultClasses.IsTarget(thisFault))
+                dominatingFaults.push_back(FaultList(masterNodeList[i].lineNumber, v));
         }
+    }
+
+    for (int i = 0; i < inTestList.size(); i++) {
+        if (inTestList[i].isTestPossible)
+            testVector.push_back(inTestList[i].testVector);
+    }
+
+    AtpgWorkers atpgWorkers (masterNodeList, masterCircuitGraph, numberThreads);
+    atpgWorkers.isPathTracing = isPathTracing;
+    atpgWorkers.GradeVectors(testVector, dominatingFaults, detectingVector);
+    for (int i = 0; i < dominatingFaults.size(); i++) {
+        if (detectingVector[i] < 0)
+            undetectedFaults.push_back(dominatingFaults[i]);
+    }
+
+    #ifdef DEBUG
+        WRITE << "Dominating classes = " << dominatingFaults.size() << endl;
+        WRITE << "Not detected by the tests = " << undetectedFaults.size() << endl << endl;
     #endif
 
-    if (isTestGenerated)
-        return true;
+    if (undetectedFaults.empty())
+        return;
+
+    if (atpgAlgorithm == ATPG_EXHAUSTIVE)
+        ExhaustiveAllFaultsATPG(inTestList, undetectedFaults);
     else
-        return false;
+        PodemAllFaultsATPG(inTestList, undetectedFaults);
 }
 
 /*
  * ===  FUNCTION  ======================================================================
- *         Name:  TestAllVectorsATPG
- *  Description:  This function reads from the vector table.
- *                It then applies each vector to CheckVectorForATPG.
- *                If a test is generated then it returns true.
- *                If no test is generated after looking at all vectors, return false.
+ *         Name:  CompactTests
+ *  Description:  Static compaction of the tests in the test list. Every fault with a
+ *                test gets a test from a smaller set of vectors, and the faults that
+ *                were detected are still detected.
+ *
+ *                First the test cubes are merged. Two cubes are compatible if no input
+ *                is 0 in one and 1 in the other, and then one vector with the inputs
+ *                of both detects the faults of both. The cubes with the most inputs set
+ *                are placed first, each one in the first vector it is compatible with.
+ *
+ *                Then the merged vectors are fault simulated in reverse order, the last
+ *                one first, against the faults of the test list (and with dominance
+ *                collapsing the dominating classes, which ExpandFaultClasses grades
+ *                later). Every fault takes the first vector that detects it, so a
+ *                vector that detects no fault that the later ones miss is dropped.
+ *                A fault that no merged vector detects keeps its own test, and a
+ *                dominating class that is the only reason to keep a vector is added
+ *                to the test list with it.
  * =====================================================================================
  */
-bool TestAllVectorsATPG (int totalInputs, int inLineNumber, bool inStuckAtValue, vector <string> &inVectorList, vector <TestList> &inTestList) {
+void CompactTests (vector <TestList> &inTestList) {
 
     #ifdef DEBUG
         WRITE << "================================================================================" << endl;
-        WRITE << "===============          In --> TestAllVectorsForATPG            ===============" << endl;
+        WRITE << "===============               In --> CompactTests                ===============" << endl;
         WRITE << "================================================================================" << endl << endl;
     #endif
 
-    string outVector;
+    int numberInputs = masterCircuitGraph.inputNodes.size();
+    int numberWords = (numberInputs + 63) / 64;
 
-    for (int i = 0; i < inVectorList.size(); i++) {
-        outVector = inVectorList[i];
-        if (CheckVectorForATPG(totalInputs, inLineNumber, inStuckAtValue, outVector)) {
-            TestList *thisTest;
-            thisTest = new TestList(inLineNumber, inStuckAtValue, outVector);
-            inTestList.push_back(*thisTest);
-            delete thisTest;
+    // The distinct cubes, the ones with the most inputs set first.
+    vector <string> testCubes;
+    for (int i = 0; i < inTestList.size(); i++) {
+        if (inTestList[i].isTestPossible)
+            testCubes.push_back(inTestList[i].testVector);
+    }
+    int numberTests = testCubes.size();
+    sort (testCubes.begin(), testCubes.end());
+    testCubes.erase(unique(testCubes.begin(), testCubes.end()), testCubes.end());
 
-            #ifdef DEBUG
-                WRITE << endl;
-                WRITE << "------------------------------------------------------------" << endl;
-                WRITE << "The fault is at line number = " << inLineNumber << endl;
-                WRITE << "The fault is stuck at = " << inStuckAtValue << endl;
-                WRITE << "Test was generated by vector = " << outVector << endl;
-                WRITE << "------------------------------------------------------------" << endl;
-                WRITE << endl;
-            #endif
-            return true;
+    vector < pair <int, int> > cubeOrder;
+    for (int i = 0; i < testCubes.size(); i++) {
+        cubeOrder.push_back(make_pair(-(int)count(testCubes[i].begin(), testCubes[i].end(), '0' + X) , i));
+    }
+    sort (cubeOrder.begin(), cubeOrder.end(), greater < pair <int, int> > ());
+
+    // The inputs that are 0 and 1 in every merged vector, 64 to a word.
+    vector <uint64_t> zeroBits;
+    vector <uint64_t> oneBits;
+    vector <string> mergedVectors;
+    for (int k = 0; k < cubeOrder.size(); k++) {
+        string &thisCube = testCubes[cubeOrder[k].second];
+        vector <uint64_t> cubeZero (numberWords, 0);
+        vector <uint64_t> cubeOne (numberWords, 0);
+        for (int i = 0; i < numberInputs; i++) {
+            if (thisCube[i] == '0' + ZERO)
+                cubeZero[i / 64] |= 1ULL << (i % 64);
+            else if (thisCube[i] == '0' + ONE)
+                cubeOne[i / 64] |= 1ULL << (i % 64);
+        }
+
+        int thisVector = 0;
+        for ( ; thisVector < mergedVectors.size(); thisVector++) {
+            bool isCompatible = true;
+            for (int w = 0; w < numberWords && isCompatible; w++) {
+                if ((cubeZero[w] & oneBits[thisVector * numberWords + w]) || (cubeOne[w] & zeroBits[thisVector * numberWords + w]))
+                    isCompatible = false;
+            }
+            if (isCompatible)
+                break;
+        }
+
+        if (thisVector == mergedVectors.size()) {
+            mergedVectors.push_back(thisCube);
+            zeroBits.insert(zeroBits.end(), cubeZero.begin(), cubeZero.end());
+            oneBits.insert(oneBits.end(), cubeOne.begin(), cubeOne.end());
+            continue;
+        }
+        for (int i = 0; i < numberInputs; i++) {
+            if (thisCube[i] != '0' + X)
+                mergedVectors[thisVector][i] = thisCube[i];
+        }
+        for (int w = 0; w < numberWords; w++) {
+            zeroBits[thisVector * numberWords + w] |= cubeZero[w];
+            oneBits[thisVector * numberWords + w] |= cubeOne[w];
+        }
+    }
+
+    // Reverse order fault simulation.
+    vector <FaultList> gradedFaults;
+    vector <int> gradedTest;                        // Index in inTestList, -1 for a dominating class.
+    vector <int> detectingVector;
+    for (int i = 0; i < inTestList.size(); i++) {
+        if (inTestList[i].isTestPossible) {
+            gradedFaults.push_back(FaultList(inTestList[i].lineNumber, inTestList[i].stuckAtValue));
+            gradedTest.push_back(i);
+        }
+    }
+    if (isDominanceCollapsing) {
+        for (int i = 0; i < masterNodeList.size(); i++) {
+            for (int v = 0; v < 2; v++) {
+                int thisFault = FaultClasses::FaultNumber(i, v);
+                if (masterFaultClasses.FindClass(thisFault) == thisFault && !masterFaultClasses.IsTarget(thisFault)) {
+                    gradedFaults.push_back(FaultList(masterNodeList[i].lineNumber, v));
+                    gradedTest.push_back(-1);
+                }
+            }
         }
     }
 
-    return false;
+    reverse (mergedVectors.begin(), mergedVectors.end());
+    AtpgWorkers atpgWorkers (masterNodeList, masterCircuitGraph, numberThreads);
+    atpgWorkers.isPathTracing = isPathTracing;
+    atpgWorkers.GradeVectors(mergedVectors, gradedFaults, detectingVector);
+
+    int numberUndetected = 0;
+    set <string> finalVectors;
+    for (int i = 0; i < gradedFaults.size(); i++) {
+        if (gradedTest[i] < 0)
+            continue;
+        TestList &thisTest = inTestList[gradedTest[i]];
+        if (detectingVector[i] >= 0)
+            thisTest.testVector = mergedVectors[detectingVector[i]];
+        else
+            numberUndetected++;
+        finalVectors.insert(thisTest.testVector);
+    }
+
+    // A vector that was only kept for a dominating class is added with that fault.
+    for (int i = 0; i < gradedFaults.size(); i++) {
+        if (gradedTest[i] < 0 && detectingVector[i] >= 0 && finalVectors.insert(mergedVectors[detectingVector[i]]).second)
+            inTestList.push_back(TestList(gradedFaults[i].lineNumber, gradedFaults[i].stuckAtValue, mergedVectors[detectingVector[i]]));
+    }
+
+    #ifdef DEBUG
+        WRITE << "Tests = " << numberTests << endl;
+        WRITE << "Distinct test cubes = " << testCubes.size() << endl;
+        WRITE << "Vectors after merging the cubes = " << mergedVectors.size() << endl;
+        WRITE << "Vectors after reverse order fault simulation = " << finalVectors.size() << endl;
+        WRITE << "Faults kept on their own test = " << numberUndetected << endl << endl;
+    #endif
 }
 
 /*
  * ===  FUNCTION  ======================================================================
- *         Name:  CheckAllFaultsATPG
- *  Description:  This function keeps checking if a test vector is possible for all the
- *                faults left in the circuit after fault collapsing. If a test is
- *                possible then it moves to next fault. If no test is found then
- *                the test possible flag in the TestList object is set to false and the
- *                next fault is checked.
+ *         Name:  ExpandFaultClasses
+ *  Description:  This function builds the test list for all the faults in the fault
+ *                list from the results of test generation. Every fault gets the result
+ *                of the representative of its class, if there is one in inClassTestList.
+ *
+ *                The faults of the dominating classes have no result of their own, so
+ *                they are graded against the given vectors instead, in the same way
+ *                as in CheckAllFaultsATPG.
  * =====================================================================================
  */
-void CheckAllFaultsATPG (int totalInputs, vector <string> &inVectorList, vector <TestList> &inTestList, vector <FaultList> &inFaultList) {
+void ExpandFaultClasses (vector <TestList> &inClassTestList, vector <string> &inVectorList,
+                         vector <FaultList> &inFaultList, vector <TestList> &outTestList) {
 
     #ifdef DEBUG
         WRITE << "================================================================================" << endl;
-        WRITE << "===============            In --> CheckAllFaultsATPG             ===============" << endl;
+        WRITE << "===============            In --> ExpandFaultClasses             ===============" << endl;
         WRITE << "================================================================================" << endl << endl;
     #endif
 
+    vector <int> classTest (2 * masterNodeList.size(), -1);     // Index in inClassTestList for each class.
+    vector <FaultList> gradedFaults;                            // Faults without a class result.
+    vector <int> gradedPosition;                                // Their position in outTestList.
+    vector <int> detectingVector;
+
+    for (int i = 0; i < inClassTestList.size(); i++) {
+        int thisNode = masterCircuitGraph.FindNode(inClassTestList[i].lineNumber);
+        if (thisNode >= 0)
+            classTest[masterFaultClasses.FindClass(FaultClasses::FaultNumber(thisNode, inClassTestList[i].stuckAtValue))] = i;
+    }
+
     for (int i = 0; i < inFaultList.size(); i++) {
-        if(!TestAllVectorsATPG (totalInputs, inFaultList[i].lineNumber, inFaultList[i].stuckAtValue, inVectorList, inTestList)) {
-            TestList *thisTest;
-            thisTest = new TestList(inFaultList[i].lineNumber, inFaultList[i].stuckAtValue);
-            inTestList.push_back(*thisTest);
-            delete thisTest;
+        int thisNode = masterCircuitGraph.FindNode(inFaultList[i].lineNumber);
+        int thisClass = masterFaultClasses.FindClass(FaultClasses::FaultNumber(thisNode, inFaultList[i].stuckAtValue));
+        int thisTest = classTest[thisClass];
 
-            #ifdef DEBUG
-                WRITE << endl;
+        if (thisTest >= 0 && inClassTestList[thisTest].isTestPossible) {
+            outTestList.push_back(TestList(inFaultList[i].lineNumber, inFaultList[i].stuckAtValue, inClassTestList[thisTest].testVector));
+        } else {
+            outTestList.push_back(TestList(inFaultList[i].lineNumber, inFaultList[i].stuckAtValue));
+            if (thisTest >= 0)
+                outTestList.back().isAborted = inClassTestList[thisTest].isAborted;
+            else {
+                gradedFaults.push_back(inFaultList[i]);
+                gradedPosition.push_back(i);
+            }
+        }
+
+        #ifdef DEBUG
+            if (thisTest >= 0) {
                 WRITE << "------------------------------------------------------------" << endl;
                 WRITE << "The fault is at line number = " << inFaultList[i].lineNumber << endl;
                 WRITE << "The fault is stuck at = " << inFaultList[i].stuckAtValue << endl;
-                WRITE << "Test cannot be generated for this fault." << endl;
+                WRITE << "Result taken from the fault at line number = " << inClassTestList[thisTest].lineNumber
+                      << ", stuck at = " << inClassTestList[thisTest].stuckAtValue << endl;
                 WRITE << "------------------------------------------------------------" << endl;
                 WRITE << endl;
-            #endif
-        }
+            }
+        #endif
+    }
+
+    if (gradedFaults.empty())
+        return;
+
+    AtpgWorkers atpgWorkers (masterNodeList, masterCircuitGraph, numberThreads);
+    atpgWorkers.isPathTracing = isPathTracing;
+    atpgWorkers.GradeVectors(inVectorList, gradedFaults, detectingVector);
+    for (int i = 0; i < gradedFaults.size(); i++) {
+        if (detectingVector[i] >= 0)
+            outTestList[gradedPosition[i]] = TestList(gradedFaults[i].lineNumber, gradedFaults[i].stuckAtValue, inVectorList[detectingVector[i]]);
+
+        #ifdef DEBUG
+            WRITE << "------------------------------------------------------------" << endl;
+            WRITE << "The fault is at line number = " << gradedFaults[i].lineNumber << endl;
+            WRITE << "The fault is stuck at = " << gradedFaults[i].stuckAtValue << endl;
+            if (detectingVector[i] >= 0)
+                WRITE << "Test was generated by vector = " << inVectorList[detectingVector[i]] << endl;
+            else
+                WRITE << "Test cannot be generated for this fault." << endl;
+            WRITE << "------------------------------------------------------------" << endl;
+            WRITE << endl;
+        #endif
     }
+}
 
+/*
+ * ===  FUNCTION  ======================================================================
+ *         Name:  PrintUsage
+ *  Description:  Prints the command line options and exits.
+ * =====================================================================================
+ */
+void PrintUsage (char *programName) {
+    cerr << "ERROR: Usage: " << programName << " [-e] [-f] [-d] [-c] [-j <Threads>] [-g <Vector Filename>] [-s] [-t] [-r <Seed>] [-R <Gain>] [-o easy|hard] [-b <Backtracks>] [-p <Seconds>] [-T <Seconds>] [-S] [-l] [-x <Targets>] [-m] [-k] <Circuit Filename> (Optional <Faultlist Filename>)" << endl;
+    cerr << "    -e  Use the exhaustive vector search instead of PODEM." << endl;
+    cerr << "    -f  Use FAN, with headlines and multiple backtrace, instead of PODEM." << endl;
+    cerr << "    -d  Drop the faults detected by earlier tests instead of searching for them." << endl;
+    cerr << "    -c  Also remove the faults that dominate other faults from the targets." << endl;
+    cerr << "    -j  Number of worker threads for test generation and grading, default 1." << endl;
+    cerr << "        With -d the tests, and so the faults aborted, can change with the number." << endl;
+    cerr << "    -g  Do not generate tests. Grade the vectors in the given file instead." << endl;
+    cerr << "    -s  Grade with the concurrent fault simulator, one vector at a time." << endl;
+    cerr << "    -t  Fault simulation with critical path tracing in the fanout-free regions." << endl;
+    cerr << "    -r  Try random patterns from the given seed before the test generation." << endl;
+    cerr << "    -R  Stop the random patterns when a block detects less than this percent of the faults." << endl;
+    cerr << "    -o  Order the faults by SCOAP testability, easy (hardest last) or hard (hardest first)." << endl;
+    cerr << "    -b  Abort the PODEM search for a fault after this many backtracks." << endl;
+    cerr << "        Default 1000, 0 for no limit." << endl;
+    cerr << "    -p  Abort the PODEM search for a fault after this many seconds." << endl;
+    cerr << "    -T  Abort all the PODEM searches still left after this many seconds." << endl;
+    cerr << "    -S  Search for the faults that PODEM aborts with the SAT solver." << endl;
+    cerr << "    -l  Static learning for PODEM, saved in <Circuit Filename>.lrn for later runs." << endl;
+    cerr << "    -x  Extend every test to detect up to this many more faults, with its X inputs." << endl;
+    cerr << "    -m  Merge the tests and drop the ones not needed, after the test generation." << endl;
+    cerr << "    -k  Keep the prepared circuit in <Circuit Filename>.cache and load it from there in later runs." << endl;
+    exit(1);
 }
 
 /*
@@ -1078,30 +1542,160 @@ int main (int argc, char *argv[]) {
     ifstream inFile;
     ofstream outFile;
 
-    if (argc <= 1 || argc > 3) {
-        cerr << "ERROR: Usage: " << argv[0] << " <Circuit Filename> (Optional <Faultlist Filename>)" << endl;
-        exit(1);
+    // Options come before the file names.
+    //      -e  Use the exhaustive vector search instead of PODEM.
+    //      -f  Use FAN instead of PODEM, see PodemSearch.
+    //      -d  Fault dropping, see PodemAllFaultsATPG.
+    //      -c  Dominance fault collapsing, see CollapseFaults.
+    //      -j  Number of worker threads.
+    //      -g  Grade the vectors in the given file, no test generation.
+    //      -s  Concurrent fault simulation for the grading, see CheckAllFaultsATPG.
+    //      -t  Critical path tracing in the fault simulation, see FaultSimulator.
+    //      -r  Random pattern phase with the given seed, see RandomPatternATPG.
+    //      -R  Gain threshold of the random pattern phase, in percent.
+    //      -o  Fault order for PODEM, easy (hardest last) or hard (hardest first).
+    //      -b  Backtrack limit per fault, see PodemAllFaultsATPG.
+    //      -p  Time limit per fault, in seconds.
+    //      -T  Time limit for the whole run, in seconds.
+    //      -S  SAT search for the aborted faults, see PodemAllFaultsATPG.
+    //      -l  Static learning, see StaticLearning.
+    //      -x  Dynamic compaction, see AtpgWorkers.
+    //      -m  Static compaction, see CompactTests.
+    //      -k  Circuit cache, see CircuitCache.
+    char *vectorFileName = NULL;
+    int option;
+    while ((option = getopt (argc, argv, "efdcj:g:str:R:o:b:p:T:Slx:mk")) != -1) {
+        switch (option) {
+            case 'e':
+                atpgAlgorithm = ATPG_EXHAUSTIVE;
+                break;
+            case 'f':
+                atpgAlgorithm = ATPG_FAN;
+                break;
+            case 'd':
+                isFaultDropping = true;
+                break;
+            case 'c':
+                isDominanceCollapsing = true;
+                break;
+            case 'j':
+                numberThreads = atoi(optarg);
+                if (numberThreads < 1)
+                    PrintUsage(argv[0]);
+                break;
+            case 'g':
+                vectorFileName = optarg;
+                break;
+            case 's':
+                isConcurrentSimulation = true;
+                break;
+            case 't':
+                isPathTracing = true;
+                break;
+            case 'r':
+                isRandomPhase = true;
+                randomSeed = strtoull(optarg, NULL, 10);
+                break;
+            case 'o':
+                if (string(optarg) == "easy")
+                    faultOrder = ORDER_EASY;
+                else if (string(optarg) == "hard")
+                    faultOrder = ORDER_HARD;
+                else
+                    PrintUsage(argv[0]);
+                break;
+            case 'R':
+                randomMinimumGain = atof(optarg);
+                if (randomMinimumGain < 0)
+                    PrintUsage(argv[0]);
+                break;
+            case 'b':
+                backtrackLimit = strtoul(optarg, NULL, 10);
+                isBacktrackLimitSet = true;
+                break;
+            case 'p':
+                faultTimeLimit = atof(optarg);
+                if (faultTimeLimit < 0)
+                    PrintUsage(argv[0]);
+                break;
+            case 'S':
+                isSatFallback = true;
+                break;
+            case 'l':
+                isStaticLearning = true;
+                break;
+            case 'm':
+                isStaticCompaction = true;
+                break;
+            case 'k':
+                isCircuitCache = true;
+                break;
+            case 'x':
+                compactionTargets = atoi(optarg);
+                if (compactionTargets < 1)
+                    PrintUsage(argv[0]);
+                break;
+            case 'T':
+                if (atof(optarg) <= 0)
+                    PrintUsage(argv[0]);
+                runStopTime = chrono::steady_clock::now() + chrono::duration_cast<chrono::steady_clock::duration>(chrono::duration<double> (atof(optarg)));
+                break;
+            default:
+                PrintUsage(argv[0]);
+                break;
+        }
+    }
+
+    if ((argc - optind) < 1 || (argc - optind) > 2) {
+        PrintUsage(argv[0]);
     }
+    char *circuitFileName = argv[optind];
+    char *faultFileName = ((argc - optind) == 2) ? argv[optind + 1] : NULL;
     int i;
 
+    // The learning and cache files are only used if they were written for this
+    // exact circuit file.
+    uint64_t circuitHash = 0;
+    if (isCircuitCache || isStaticLearning)
+        circuitHash = hashFile(circuitFileName);
+
+    string cacheFileName = string(circuitFileName) + ".cache";
+    if (isCircuitCache)
+        isCircuitLoaded = masterCircuitCache.Load((char *)cacheFileName.c_str(), circuitHash, isDominanceCollapsing);
+
     // The first argument to the program is the circuit file.
-    openInFile (argv[1], inFile, logFile);
-    ReadCircuit (inFile);
-    inFile.close();
+    if (!isCircuitLoaded) {
+        ReadCircuit (circuitFileName);
+    }
 
     // If there is a second argument present, then that is the provided fault
     // list that we have to obtain the vectors for.
     //
     // If the argument is given, parse the file and create a list of faults to
     // be checked.
-    if (argc == 3) {
-        openInFile (argv[2], inFile, logFile);
-        ReadFaultList(inFile);
-        inFile.close();
+    if (faultFileName != NULL) {
+        ReadFaultList(faultFileName);
     }
 
     // Levelize the circuit.
-    SetLineLevel(masterNodeList);
+    if (!isCircuitLoaded)
+        SetLineLevel(masterNodeList);
+
+    if (isStaticLearning && vectorFileName == NULL && atpgAlgorithm != ATPG_EXHAUSTIVE) {
+        string learningFileName = string(circuitFileName) + ".lrn";
+        bool isLoaded = masterStaticLearning.Load((char *)learningFileName.c_str(), circuitHash);
+        if (!isLoaded) {
+            masterStaticLearning.Learn();
+            if (!masterStaticLearning.Save((char *)learningFileName.c_str(), circuitHash))
+                cerr << "WARNING: Learning file " << learningFileName << " could not be written." << endl;
+        }
+
+        #ifdef DEBUG
+            WRITE << (isLoaded ? "Static learning loaded from " : "Static learning saved to ") << learningFileName << endl;
+            WRITE << "Learnt implications = " << masterStaticLearning.NumberImplications() << endl;
+            WRITE << "Impossible line values = " << masterStaticLearning.NumberImpossible() << endl << endl;
+        #endif
+    }
 
     // Create a list of faults to be collapsed.
     //
@@ -1113,66 +1707,109 @@ int main (int argc, char *argv[]) {
     // check all the faults in the circuit.
     //
     // So we create a list of all faults in the circuit.
-    if (argc == 2) {
+    if (faultFileName == NULL) {
         CreateFaultList(finalFaultList);
     }
 
     // Then we collapse the faults.
     CollapseFaults(masterLineList, masterNodeList);
 
+    if (isCircuitCache && !isCircuitLoaded) {
+        if (!masterCircuitCache.Save((char *)cacheFileName.c_str(), circuitHash, isDominanceCollapsing))
+            cerr << "WARNING: Cache file " << cacheFileName << " could not be written." << endl;
+    }
+
+    #ifdef DEBUG
+        if (isCircuitCache)
+            WRITE << (isCircuitLoaded ? "Circuit loaded from " : "Circuit saved to ") << cacheFileName << endl << endl;
+    #endif
+
     // We create a master list of faults after collapsing the faults.
     //
     // This list is used to find the test vectors that can identify all
     // detectable faults in the circuit.
     CreateFaultList(masterFaultList);
 
-    // We create a master list of possible inputs. This is a pseudo sequence that
-    // goes on checking the circuit by first setting only one input and then moving
-    // on with 2, 3 till it finds proper test.
-    GenerateMasterInputVectors(CircuitNode::totalInputs);
+    // In the grading mode the vectors come from the given file. Otherwise they are
+    // the tests generated for the collapsed faults.
+    if (vectorFileName != NULL) {
+        openInFile (vectorFileName, inFile, logFile);
+        ReadVectorFile(inFile, masterTestVector);
+        inFile.close();
+    } else {
+        // Not really necessary. We just simulate the fault free circuit for all possible inputs.
+        // Uncomment this part if you want simple logic simulation.
+        /*
+        VectorEnumerator vectorEnumerator (CircuitNode::totalInputs);
+        string thisVector;
+        while (vectorEnumerator.NextVector(thisVector)) {
+            SimpleLogicSimulation(CircuitNode::totalInputs, thisVector);
+        }
+        */
+
+        cout << "=========================================================" << endl;
+        cout << "==========           Starting PODEM            ==========" << endl;
+        cout << "=========================================================" << endl;
+
+        // This routine generates a list of vectors (the masterTestList) that has the faults in the circuit
+        // and the vectors associated with each test.
+        //
+        // The exhaustive search is a pseudo sequence that goes on checking the circuit by first
+        // setting only one input and then moving on with 2, 3 till it finds proper test.
+        //
+        // With the random phase, only the faults that the random patterns do not
+        // detect are left for the search.
+        vector <FaultList> hardFaultList;
+        if (isRandomPhase)
+            RandomPatternATPG(masterTestList, masterFaultList, hardFaultList);
+        else
+            hardFaultList = masterFaultList;
 
-    // Not really necessary. We just simulate the fault free circuit for all possible inputs.
-    // Uncomment this part if you want simple logic simulation.
-    /*
-    vector <string>::iterator itrVector;
-    for (itrVector = masterInputVector.begin(); itrVector != masterInputVector.end(); itrVector++) {
-        SimpleLogicSimulation(CircuitNode::totalInputs, *itrVector);
-    }
-    */
+        if (atpgAlgorithm == ATPG_EXHAUSTIVE)
+            ExhaustiveAllFaultsATPG(masterTestList, hardFaultList);
+        else
+            PodemAllFaultsATPG(masterTestList, hardFaultList);
 
-    cout << "=========================================================" << endl;
-    cout << "==========           Starting PODEM            ==========" << endl;
-    cout << "=========================================================" << endl;
+        // The dominating classes were not targeted, make sure they are detected too.
+        if (isDominanceCollapsing)
+            TargetDominatingFaults(masterTestList);
 
-    // This routine generates a list of vectors (the masterTestList) that has the faults in the circuit
-    // and the vectors associated with each test.
-    CheckAllFaultsATPG(CircuitNode::totalInputs, masterInputVector, masterTestList, masterFaultList);
+        if (isStaticCompaction)
+            CompactTests(masterTestList);
 
-    // Here we print all the faults, the faults and the test vectors associated with them.
-    for (int i = 0; i < masterTestList.size(); i++) {
-        cout << "Test Information For" << endl;
-        cout << "------------------------------------------------------------" << endl;
-        cout << "Line Number Is = " << masterTestList[i].lineNumber << endl;
-        cout << "Fault Is Stuck At = " << masterTestList[i].stuckAtValue << endl;
-        if (masterTestList[i].isTestPossible) {
-            cout << "Test Vector Is = " << StringConvert(masterTestList[i].testVector) << endl;
-        } else {
-            cout << "Test is not possible for this fault." << endl;
+        // Here we print all the faults, the faults and the test vectors associated with them.
+        for (int i = 0; i < masterTestList.size(); i++) {
+            cout << "Test Information For" << endl;
+            cout << "------------------------------------------------------------" << endl;
+            cout << "Line Number Is = " << masterTestList[i].lineNumber << endl;
+            cout << "Fault Is Stuck At = " << masterTestList[i].stuckAtValue << endl;
+            if (masterTestList[i].isTestPossible) {
+                cout << "Test Vector Is = " << StringConvert(masterTestList[i].testVector) << endl;
+            } else if (masterTestList[i].isAborted) {
+                cout << "Test generation was aborted for this fault." << endl;
+            } else {
+                cout << "Test is not possible for this fault." << endl;
+            }
+            cout << endl;
         }
-        cout << endl;
-    }
 
-    // Here we create a list of all the vectors that were created in the last step.
-    // This list should, theoretically, be able to test all faults in the circuit.
-    //
-    // Only add the vectors where test was possible. Don't add otherwise.
-    for (int i = 0; i < masterTestList.size(); i++) {
-        if (masterTestList[i].isTestPossible)
-            masterTestVector.push_back(masterTestList[i].testVector);
+        // Here we create a list of all the vectors that were created in the last step.
+        // This list should, theoretically, be able to test all faults in the circuit.
+        //
+        // Only add the vectors where test was possible. Don't add otherwise.
+        for (int i = 0; i < masterTestList.size(); i++) {
+            if (masterTestList[i].isTestPossible)
+                masterTestVector.push_back(masterTestList[i].testVector);
+        }
+
+        #ifdef DEBUG
+            WRITE << "Test vectors = " << masterTestVector.size() << endl;
+            WRITE << "Distinct test vectors = " << set <string> (masterTestVector.begin(), masterTestVector.end()).size() << endl << endl;
+        #endif
     }
 
     cout << "=========================================================" << endl;
-    if (argc == 3) {
+    if (faultFileName != NULL) {
         cout << "==========      Checking for given faults.     ==========" << endl;
     } else {
         cout << "========== Checking for all faults in circuit. ==========" << endl;
@@ -1182,12 +1819,15 @@ int main (int argc, char *argv[]) {
     // Now, if there was a fault list given, we try to test the faults in the list using
     // the master test vector list created in the last step.
     //
-    // If there was no fault list provided then we test the circuit for all the faults in
-    // the circuit (stuck at 0 and 1 on each line).
-    if (argc == 3) {
-        CheckAllFaultsATPG(CircuitNode::totalInputs, masterTestVector, finalTestList, providedFaultList);
+    // If there was no fault list provided then we report all the faults in the circuit
+    // (stuck at 0 and 1 on each line). Every fault gets the result of its class, so
+    // this is only a grading run in the grading mode.
+    if (faultFileName != NULL) {
+        CheckAllFaultsATPG(masterTestVector, finalTestList, providedFaultList);
+    } else if (vectorFileName != NULL) {
+        CheckAllFaultsATPG(masterTestVector, finalTestList, finalFaultList);
     } else {
-        CheckAllFaultsATPG(CircuitNode::totalInputs, masterTestVector, finalTestList, finalFaultList);
+        ExpandFaultClasses(masterTestList, masterTestVector, finalFaultList, finalTestList);
     }
 
     // We just pring the information out to screen here.
@@ -1200,6 +1840,27 @@ int main (int argc, char *argv[]) {
         cout << endl;
     }
 
+    // Fault coverage over all the faults that were checked.
+    int numberDetected = 0;
+    int numberAborted = 0;
+    for (int i = 0; i < finalTestList.size(); i++) {
+        if (finalTestList[i].isTestPossible)
+            numberDetected++;
+        else if (finalTestList[i].isAborted)
+            numberAborted++;
+    }
+    cout << "Faults detected = " << numberDetected << " of " << finalTestList.size() << endl;
+    if (numberAborted > 0)
+        cout << "Faults aborted = " << numberAborted << endl;
+    if (!finalTestList.empty())
+        cout << "Fault coverage = " << (100.0 * numberDetected / finalTestList.size()) << " %" << endl;
+    cout << endl;
+
+    #ifdef DEBUG
+        WRITE << "Faults detected = " << numberDetected << " of " << finalTestList.size() << endl;
+        WRITE << "Faults aborted = " << numberAborted << endl << endl;
+    #endif
+
     // If result file is defined then we dump the whole result in a file
     // in the format specified below. This is defined in the global defines file.
     //
@@ -1207,14 +1868,19 @@ int main (int argc, char *argv[]) {
     // testVector
     // lineNumber stuckAtFault
     // testVector
+    //
+    // No vectors are generated in the grading mode, so the vector file is
+    // left as it is.
     #ifdef RESULT_FILE
-        openOutFile((char *)VECTOR_FILE_NAME, outFile, logFile);
+        if (vectorFileName == NULL) {
+            openOutFile((char *)VECTOR_FILE_NAME, outFile, logFile);
 
-        for (int i = 0; i < masterTestList.size(); i++) {
-            outFile << masterTestList[i].lineNumber << " " << masterTestList[i].stuckAtValue << endl << StringConvert(masterTestList[i].testVector) << endl;
-        }
+            for (int i = 0; i < masterTestList.size(); i++) {
+                outFile << masterTestList[i].lineNumber << " " << masterTestList[i].stuckAtValue << endl << StringConvert(masterTestList[i].testVector) << endl;
+            }
 
-        outFile.close();
+            outFile.close();
+        }
 
         openOutFile((char *)REPORT_FILE_NAME, outFile, logFile);
 
@@ -1222,6 +1888,8 @@ int main (int argc, char *argv[]) {
             outFile << finalTestList[i].lineNumber << " " << finalTestList[i].stuckAtValue << endl << StringConvert(finalTestList[i].testVector) << endl;
             if (finalTestList[i].isTestPossible)
                 outFile << "Yes" << endl;
+            else if (finalTestList[i].isAborted)
+                outFile << "Aborted" << endl;
             else
                 outFile << "No" << endl;
         }
@@ -1238,15 +1906,14 @@ int main (int argc, char *argv[]) {
      */
 
     #ifdef DEBUG_PRINT
-        set <int>::iterator it;
         for (i = 0; i < masterNodeList.size(); i++) {
             cout << "-----------------------------------------------------" << endl;
             cout << endl << endl;
             cout << " Node   Type \tIn\t\tOut\t\tFaults" << endl;
             for(i = 0; i<CircuitNode::totalNodes; i++) {
                 cout << "\t\t\t\t";
-                for(it = masterNodeList[i].listFanOut.begin(); it != masterNodeList[i].listFanOut.end(); it++) {
-                    cout << *it << ", ";
+                for (int k = masterCircuitGraph.fanOutStart[i]; k < masterCircuitGraph.fanOutStart[i + 1]; k++) {
+                    cout << masterNodeList[masterCircuitGraph.fanOutList[k]].lineNumber << ", ";
                 }
                 cout << "\b\b ";
 
@@ -1254,8 +1921,8 @@ int main (int argc, char *argv[]) {
 
                 printf("\r%5d      %d\t", masterNodeList[i].lineNumber, masterNodeList[i].gateType);
 
-                for(it = masterNodeList[i].listFanIn.begin(); it != masterNodeList[i].listFanIn.end(); it++) {
-                    cout << *it << ", ";
+                for (int k = masterCircuitGraph.fanInStart[i]; k < masterCircuitGraph.fanInStart[i + 1]; k++) {
+                    cout << masterNodeList[masterCircuitGraph.fanInList[k]].lineNumber << ", ";
                 }
                 cout << "\b\b ";
 
@@ -0,0 +1,310 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  AtpgWorkers.cc
+ *
+ *    Description:  This file defines the methods in the AtpgWorkers class.
+ *                  The class runs test generation and fault grading on several
+ *                  threads.
+ *
+ *        Version:  1.0
+ *        Created:  12/02/2011
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  Aditya Shevade <aditya.shevade@gmail.com>,
+ *                  Amey Marathe <marathe.amey@gmail.com>,
+ *                  Samik Biswas <samiksb@gmail.com>,
+ *                  Viraj Bhogle <viraj.bhogle@gmail.com>
+ *
+ * =====================================================================================
+ */
+
+#include "AtpgWorkers.h"
+
+// Global constants are defined in this file.
+
+#ifndef GLOBAL_DEFINES_H_
+#include "../include/global_defines.h"
+#endif
+
+namespace nameSpace_ATPG {
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  AtpgWorkers
+ *      Method:  AtpgWorkers :: AtpgWorkers
+ * Description:  Takes in the node list of the circuit, its graph and the number of
+ *               worker threads. The circuit must already be levelized.
+ *--------------------------------------------------------------------------------------
+ */
+AtpgWorkers::AtpgWorkers (vector <CircuitNode> &inNodeList, CircuitGraph &inGraph, int inNumberWorkers) : nodeList (inNodeList), graph (inGraph) {
+
+    numberWorkers = (inNumberWorkers < 1 ? 1 : inNumberWorkers);
+    totalSearches = 0;
+    totalDecisions = 0;
+    totalBacktracks = 0;
+    totalPrunes = 0;
+    totalSecondaryTargets = 0;
+    totalSecondaryDetected = 0;
+    isPathTracing = false;
+    isSatSearch = false;
+    isFanSearch = false;
+    staticLearning = NULL;
+    compactionTargets = 0;
+    backtrackLimit = 0;
+    timeLimit = 0;
+    stopTime = chrono::steady_clock::time_point::max();
+    workQueue = NULL;
+    faultList = NULL;
+    vectorList = NULL;
+    testVector = NULL;
+    detectingVector = NULL;
+    isFaultDropping = false;
+    partSize = 0;
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  AtpgWorkers
+ *      Method:  AtpgWorkers :: RunWorkers
+ * Description:  Runs the given work function once per worker and waits for all of
+ *               them. Worker 0 runs on the calling thread.
+ *--------------------------------------------------------------------------------------
+ */
+void AtpgWorkers::RunWorkers (void (AtpgWorkers::*inWork) (int)) {
+
+    vector <thread> workerThread;
+
+    for (int w = 1; w < numberWorkers; w++) {
+        workerThread.push_back(thread(inWork, this, w));
+    }
+    (this->*inWork)(0);
+    for (int w = 0; w < workerThread.size(); w++) {
+        workerThread[w].join();
+    }
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  AtpgWorkers
+ *      Method:  AtpgWorkers :: GenerateTests
+ * Description:  Runs PODEM, or SatAtpg with isSatSearch, for every fault in the
+ *               list. For every fault, outFaultStatus has FAULT_DETECTED,
+ *               FAULT_DROPPED, FAULT_REDUNDANT or FAULT_ABORTED, and outTestVector
+ *               has the test, or an empty string for a redundant or aborted fault.
+ *--------------------------------------------------------------------------------------
+ */
+void AtpgWorkers::GenerateTests (vector <FaultList> &inFaultList, bool inFaultDropping,
+                                 vector <int> &outFaultStatus, vector <string> &outTestVector) {
+
+    WorkQueue thisQueue (inFaultList.size(), numberWorkers);
+
+    faultStatus = vector < atomic <int> > (inFaultList.size());
+    for (int i = 0; i < inFaultList.size(); i++) {
+        faultStatus[i].store(FAULT_PENDING);
+    }
+    outTestVector.assign(inFaultList.size(), "");
+
+    workQueue = &thisQueue;
+    faultList = &inFaultList;
+    testVector = &outTestVector;
+    isFaultDropping = inFaultDropping;
+
+    RunWorkers(&AtpgWorkers::GenerateWorker);
+
+    outFaultStatus.resize(inFaultList.size());
+    for (int i = 0; i < inFaultList.size(); i++) {
+        outFaultStatus[i] = faultStatus[i].load();
+    }
+    workQueue = NULL;
+    faultList = NULL;
+    testVector = NULL;
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  AtpgWorkers
+ *      Method:  AtpgWorkers :: GenerateWorker
+ * Description:  Test generation loop of one worker.
+ *
+ *               When a test is found, the faults still in FAULT_PENDING are simulated
+ *               with it. A detected fault is only dropped if it is still pending at
+ *               that point, otherwise another worker has already taken it.
+ *--------------------------------------------------------------------------------------
+ */
+void AtpgWorkers::GenerateWorker (int inWorker) {
+
+    PodemSearch podem (nodeList, graph);
+    podem.backtrackLimit = backtrackLimit;
+    podem.timeLimit = timeLimit;
+    podem.stopTime = stopTime;
+    podem.staticLearning = staticLearning;
+    podem.isFanSearch = isFanSearch;
+    SatAtpg satAtpg (nodeList, graph);
+    satAtpg.conflictLimit = backtrackLimit;
+    satAtpg.timeLimit = timeLimit;
+    satAtpg.stopTime = stopTime;
+    FaultSimulator faultSimulator (nodeList, graph);
+    faultSimulator.isPathTracing = isPathTracing;
+    vector <int> remainingFaults;
+    vector <int> detectedFaults;
+    vector <int> secondaryFaults;
+    string outVector;
+    unsigned long numberSearches = 0;
+    unsigned long numberSecondaryTargets = 0;
+    unsigned long numberSecondaryDetected = 0;
+    int thisFault;
+
+    while (workQueue->NextItem(inWorker, thisFault)) {
+        int expected = FAULT_PENDING;
+        if (!faultStatus[thisFault].compare_exchange_strong(expected, FAULT_SEARCHING))
+            continue;
+
+        numberSearches++;
+        int searchStatus;
+        if (isSatSearch)
+            searchStatus = satAtpg.GenerateTest((*faultList)[thisFault].lineNumber, (*faultList)[thisFault].stuckAtValue, outVector);
+        else
+            searchStatus = podem.GenerateTest((*faultList)[thisFault].lineNumber, (*faultList)[thisFault].stuckAtValue, outVector);
+        if (searchStatus != FAULT_DETECTED) {
+            faultStatus[thisFault].store(searchStatus);
+            continue;
+        }
+
+        // Dynamic compaction, more faults are searched for with the X inputs left.
+        secondaryFaults.clear();
+        if (compactionTargets > 0) {
+            unsigned long thisLimit = podem.backtrackLimit;
+            if (thisLimit == 0 || thisLimit > COMPACTION_BACKTRACKS)
+                podem.backtrackLimit = COMPACTION_BACKTRACKS;
+
+            int numberTargets = 0;
+            for (int i = 0; i < faultList->size() && numberTargets < compactionTargets; i++) {
+                if (outVector.find('0' + X) == string::npos)
+                    break;
+                if (faultStatus[i].load() != FAULT_PENDING)
+                    continue;
+                numberTargets++;
+                if (podem.ExtendTest((*faultList)[i].lineNumber, (*faultList)[i].stuckAtValue, outVector) == FAULT_DETECTED)
+                    secondaryFaults.push_back(i);
+            }
+            numberSecondaryTargets += numberTargets;
+            podem.backtrackLimit = thisLimit;
+        }
+
+        (*testVector)[thisFault] = outVector;
+        faultStatus[thisFault].store(FAULT_DETECTED);
+        for (int i = 0; i < secondaryFaults.size(); i++) {
+            expected = FAULT_PENDING;
+            if (faultStatus[secondaryFaults[i]].compare_exchange_strong(expected, FAULT_DROPPED)) {
+                (*testVector)[secondaryFaults[i]] = outVector;
+                numberSecondaryDetected++;
+            }
+        }
+
+        if (!isFaultDropping)
+            continue;
+
+        remainingFaults.clear();
+        for (int i = 0; i < faultList->size(); i++) {
+            if (faultStatus[i].load() == FAULT_PENDING)
+                remainingFaults.push_back(i);
+        }
+        if (remainingFaults.empty())
+            continue;
+
+        faultSimulator.SimulateVector(outVector, *faultList, remainingFaults, detectedFaults);
+        for (int i = 0; i < detectedFaults.size(); i++) {
+            expected = FAULT_PENDING;
+            if (faultStatus[detectedFaults[i]].compare_exchange_strong(expected, FAULT_DROPPED))
+                (*testVector)[detectedFaults[i]] = outVector;
+        }
+    }
+
+    lock_guard <mutex> thisLock (totalLock);
+    totalSearches += numberSearches;
+    totalDecisions += podem.totalDecisions + satAtpg.totalDecisions;
+    totalBacktracks += podem.totalBacktracks + satAtpg.totalConflicts;
+    totalPrunes += podem.totalPrunes;
+    totalSecondaryTargets += numberSecondaryTargets;
+    totalSecondaryDetected += numberSecondaryDetected;
+    simulationCounters.Add(faultSimulator.counters);
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  AtpgWorkers
+ *      Method:  AtpgWorkers :: GradeVectors
+ * Description:  Same as FaultSimulator :: GradeVectors, with the fault list split
+ *               into parts that are graded by the workers.
+ *
+ *               A fault is graded the same way whatever part it is in, so the result
+ *               does not depend on the number of workers.
+ *--------------------------------------------------------------------------------------
+ */
+void AtpgWorkers::GradeVectors (vector <string> &inVectorList, vector <FaultList> &inFaultList, vector <int> &outDetectingVector) {
+
+    if (numberWorkers == 1) {
+        FaultSimulator faultSimulator (nodeList, graph);
+        faultSimulator.isPathTracing = isPathTracing;
+        faultSimulator.GradeVectors(inVectorList, inFaultList, outDetectingVector);
+        simulationCounters.Add(faultSimulator.counters);
+        return;
+    }
+
+    // A few parts per worker, so a worker that is done early can steal some.
+    partSize = (inFaultList.size() + 4 * numberWorkers - 1) / (4 * numberWorkers);
+    if (partSize < 1)
+        partSize = 1;
+    int numberParts = (inFaultList.size() + partSize - 1) / partSize;
+    WorkQueue thisQueue (numberParts, numberWorkers);
+
+    outDetectingVector.assign(inFaultList.size(), -1);
+    workQueue = &thisQueue;
+    faultList = &inFaultList;
+    vectorList = &inVectorList;
+    detectingVector = &outDetectingVector;
+
+    RunWorkers(&AtpgWorkers::GradeWorker);
+
+    workQueue = NULL;
+    faultList = NULL;
+    vectorList = NULL;
+    detectingVector = NULL;
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  AtpgWorkers
+ *      Method:  AtpgWorkers :: GradeWorker
+ * Description:  Grading loop of one worker. Every worker writes only the entries of
+ *               the parts it took.
+ *--------------------------------------------------------------------------------------
+ */
+void AtpgWorkers::GradeWorker (int inWorker) {
+
+    FaultSimulator faultSimulator (nodeList, graph);
+    faultSimulator.isPathTracing = isPathTracing;
+    vector <FaultList> partFaults;
+    vector <int> partDetecting;
+    int thisPart;
+
+    while (workQueue->NextItem(inWorker, thisPart)) {
+        int firstFault = thisPart * partSize;
+        int lastFault = firstFault + partSize;
+        if (lastFault > faultList->size())
+            lastFault = faultList->size();
+
+        partFaults.assign(faultList->begin() + firstFault, faultList->begin() + lastFault);
+        faultSimulator.GradeVectors(*vectorList, partFaults, partDetecting);
+        for (int i = 0; i < partDetecting.size(); i++) {
+            (*detectingVector)[firstFault + i] = partDetecting[i];
+        }
+    }
+
+    lock_guard <mutex> thisLock (totalLock);
+    simulationCounters.Add(faultSimulator.counters);
+}
+
+} /* namespace nameSpace_ATPG */
@@ -0,0 +1,133 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  AtpgWorkers.h
+ *
+ *    Description:  The AtpgWorkers class. This class runs test generation and fault
+ *                  grading on several threads, one fault at a time per thread.
+ *
+ *                  The node list and the circuit graph are shared and only read. Every
+ *                  worker has its own PodemSearch, SatAtpg and FaultSimulator, so the
+ *                  line values are private to the worker. The faults are handed out
+ *                  by a WorkQueue.
+ *
+ *        Version:  1.0
+ *        Created:  12/02/2011
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  Aditya Shevade <aditya.shevade@gmail.com>,
+ *                  Amey Marathe <marathe.amey@gmail.com>,
+ *                  Samik Biswas <samiksb@gmail.com>,
+ *                  Viraj Bhogle <viraj.bhogle@gmail.com>
+ *
+ * =====================================================================================
+ */
+
+#ifndef ATPGWORKERS_H_
+#define ATPGWORKERS_H_
+
+namespace nameSpace_ATPG {
+
+
+/*
+ * =====================================================================================
+ *        Class:  AtpgWorkers
+ *  Description:  The results are returned per fault, in the order of the fault list,
+ *                so the caller builds the test list the same way for any number of
+ *                workers. With one worker everything runs on the calling thread and
+ *                the results are the same as a plain loop over the faults.
+ *
+ *                With fault dropping, the state of every fault is kept in an atomic
+ *                integer (FAULT_PENDING etc.). A worker only searches a fault that it
+ *                moved from FAULT_PENDING to FAULT_SEARCHING, and only drops a fault
+ *                that it moved from FAULT_PENDING to FAULT_DROPPED, so no fault is
+ *                ever handled twice.
+ *
+ *                With dynamic compaction, every new test is used as the start of up
+ *                to compactionTargets more searches (PodemSearch :: ExtendTest), for
+ *                the pending faults in list order, each with at most
+ *                COMPACTION_BACKTRACKS backtracks. Every fault that is found this way
+ *                is dropped, and all of them, with the first, get the final test.
+ *                The search for a pending fault is not claimed, so if another worker
+ *                takes that fault first the X inputs set for it are simply wasted.
+ * =====================================================================================
+ */
+class AtpgWorkers {
+    public:
+        unsigned    long    totalSearches;      // PODEM (or SAT) searches, all workers.
+        unsigned    long    totalDecisions;     // Primary input assignments (or solver decisions).
+        unsigned    long    totalBacktracks;    // Decisions that had to be reversed (or conflicts).
+        unsigned    long    totalPrunes;        // PODEM dead ends found by static learning.
+        unsigned    long    totalSecondaryTargets;  // Faults tried by dynamic compaction.
+        unsigned    long    totalSecondaryDetected; // Faults added to a test by it.
+        SimulationCounters  simulationCounters; // Fault simulation work, all workers.
+        bool                isPathTracing;      // Fault simulation with critical path tracing.
+        bool                isSatSearch;        // Search with SatAtpg instead of PODEM.
+        bool                isFanSearch;        // PODEM in FAN mode, see PodemSearch.
+        StaticLearning      *staticLearning;    // Learnt implications for PODEM, NULL for none.
+        int                 compactionTargets;  // Faults tried per test, 0 for no dynamic compaction.
+
+        unsigned    long    backtrackLimit;     // PODEM limits, see PodemSearch. Conflicts for SAT.
+                    double  timeLimit;
+        chrono::steady_clock::time_point stopTime;
+
+        /*
+         *--------------------------------------------------------------------------------------
+         *       Class:  AtpgWorkers
+         *      Method:  AtpgWorkers :: AtpgWorkers
+         * Description:  Takes in the node list of the circuit, its graph and the number of
+         *               worker threads. The circuit must already be levelized.
+         *--------------------------------------------------------------------------------------
+         */
+        AtpgWorkers (vector <CircuitNode> &inNodeList, CircuitGraph &inGraph, int inNumberWorkers);
+
+        /*
+         *--------------------------------------------------------------------------------------
+         *       Class:  AtpgWorkers
+         *      Method:  AtpgWorkers :: GenerateTests
+         * Description:  Runs PODEM, or SatAtpg with isSatSearch, for every fault in the
+         *               list. For every fault, outFaultStatus has FAULT_DETECTED,
+         *               FAULT_DROPPED, FAULT_REDUNDANT or FAULT_ABORTED, and outTestVector
+         *               has the test, or an empty string for a redundant or aborted fault.
+         *
+         *               With fault dropping, every new test is simulated against the
+         *               faults that no worker has taken yet, and those are dropped.
+         *--------------------------------------------------------------------------------------
+         */
+        void GenerateTests (vector <FaultList> &inFaultList, bool inFaultDropping,
+                            vector <int> &outFaultStatus, vector <string> &outTestVector);
+
+        /*
+         *--------------------------------------------------------------------------------------
+         *       Class:  AtpgWorkers
+         *      Method:  AtpgWorkers :: GradeVectors
+         * Description:  Same as FaultSimulator :: GradeVectors, with the fault list split
+         *               into parts that are graded by the workers.
+         *--------------------------------------------------------------------------------------
+         */
+        void GradeVectors (vector <string> &inVectorList, vector <FaultList> &inFaultList, vector <int> &outDetectingVector);
+
+    private:
+        vector <CircuitNode>        &nodeList;      // The circuit, read only.
+        CircuitGraph                &graph;         // Fan in and fan out of the nodes, read only.
+        int                         numberWorkers;
+
+        // The current job, shared by the workers.
+        WorkQueue                   *workQueue;
+        vector <FaultList>          *faultList;
+        vector <string>             *vectorList;
+        vector <string>             *testVector;
+        vector <int>                *detectingVector;
+        vector < atomic <int> >     faultStatus;
+        bool                        isFaultDropping;
+        int                         partSize;       // Faults per part when grading.
+        mutex                       totalLock;      // Protects the totals.
+
+        void    RunWorkers (void (AtpgWorkers::*inWork) (int));
+        void    GenerateWorker (int inWorker);
+        void    GradeWorker (int inWorker);
+};
+
+} /* namespace nameSpace_ATPG */
+#endif /* ATPGWORKERS_H_ */
@@ -0,0 +1,385 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  CircuitCache.cc
+ *
+ *    Description:  This file defines the methods in the CircuitCache class.
+ *                  The class saves the prepared circuit to a binary file and loads
+ *                  it back in later runs on the same circuit.
+ *
+ *        Version:  1.0
+ *        Created:  12/02/2011
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  Aditya Shevade <aditya.shevade@gmail.com>,
+ *                  Amey Marathe <marathe.amey@gmail.com>,
+ *                  Samik Biswas <samiksb@gmail.com>,
+ *                  Viraj Bhogle <viraj.bhogle@gmail.com>
+ *
+ * =====================================================================================
+ */
+
+#include "CircuitCache.h"
+
+// Global constants are defined in this file.
+
+#ifndef GLOBAL_DEFINES_H_
+#include "../include/global_defines.h"
+#endif
+
+namespace nameSpace_ATPG {
+
+/*
+ * Words of the header of a cache file. The arrays follow in this order - the
+ * nodes, lineToNode, sortedLines, sortedNodes, fanInStart, fanInList, fanOutStart,
+ * fanOutList, inputNodes, outputNodes, levelOrder, levelStart, the parent of every
+ * fault and the dominating flag of every fault.
+ */
+#define CACHE_MAGIC             0   // CIRCUIT_CACHE_MAGIC.
+#define CACHE_VERSION           1   // CIRCUIT_CACHE_VERSION.
+#define CACHE_HASH              2   // Hash of the circuit file.
+#define CACHE_DOMINANCE         3   // 1 if the fault classes were built with dominance.
+#define CACHE_NODE_SIZE         4   // sizeof(CircuitNode).
+#define CACHE_FILE_SIZE         5   // Size of the whole file in bytes.
+#define CACHE_NODES             6
+#define CACHE_INPUTS            7
+#define CACHE_OUTPUTS           8
+#define CACHE_LINE_TABLE        9   // Size of lineToNode.
+#define CACHE_FAN_INS           10  // Size of fanInList.
+#define CACHE_FAN_OUTS          11  // Size of fanOutList.
+#define CACHE_LEVEL_STARTS      12  // Size of levelStart.
+#define CACHE_MAX_FAN_IN        13
+#define CACHE_MAX_LEVEL         14
+#define CACHE_CLASSES           15
+#define CACHE_TARGETS           16
+#define CACHE_SORTED_LINES      17  // Size of sortedLines and of sortedNodes.
+#define CACHE_CHECKSUM          18  // Hash of everything after the header.
+#define CACHE_HEADER_WORDS      19
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  CircuitCache
+ *      Method:  CircuitCache :: CircuitCache
+ * Description:  Takes in the node list, the graph and the fault classes that are
+ *               saved from or loaded into.
+ *--------------------------------------------------------------------------------------
+ */
+CircuitCache::CircuitCache (vector <CircuitNode> &inNodeList, CircuitGraph &inGraph, FaultClasses &inFaultClasses) :
+                            nodeList (inNodeList), graph (inGraph), faultClasses (inFaultClasses) {
+}
+
+/*
+ * ===  FUNCTION  ======================================================================
+ *         Name:  cacheArraySize
+ *  Description:  Bytes taken by an array of the given number of elements in a cache
+ *                file, rounded up to 8 so the next array is aligned.
+ * =====================================================================================
+ */
+static size_t cacheArraySize (size_t inCount, size_t inElementSize) {
+    return (inCount * inElementSize + 7) & ~(size_t)7;
+}
+
+/*
+ * ===  FUNCTION  ======================================================================
+ *         Name:  cacheFileSize
+ *  Description:  Size of the cache file with the array sizes in the header.
+ * =====================================================================================
+ */
+static size_t cacheFileSize (const uint64_t *inHeader) {
+    size_t totalNodes = inHeader[CACHE_NODES];
+    size_t totalFaults = 2 * totalNodes;
+    return sizeof(uint64_t) * CACHE_HEADER_WORDS +
+           cacheArraySize(totalNodes, sizeof(CircuitNode)) +
+           cacheArraySize(inHeader[CACHE_LINE_TABLE], sizeof(int)) +
+           cacheArraySize(inHeader[CACHE_SORTED_LINES], sizeof(unsigned int)) +
+           cacheArraySize(inHeader[CACHE_SORTED_LINES], sizeof(int)) +
+           2 * cacheArraySize(totalNodes + 1, sizeof(int)) +
+           cacheArraySize(inHeader[CACHE_FAN_INS], sizeof(int)) +
+           cacheArraySize(inHeader[CACHE_FAN_OUTS], sizeof(int)) +
+           cacheArraySize(inHeader[CACHE_INPUTS], sizeof(int)) +
+           cacheArraySize(inHeader[CACHE_OUTPUTS], sizeof(int)) +
+           cacheArraySize(totalNodes, sizeof(int)) +
+           cacheArraySize(inHeader[CACHE_LEVEL_STARTS], sizeof(int)) +
+           cacheArraySize(totalFaults, sizeof(int)) +
+           cacheArraySize(totalFaults, sizeof(char));
+}
+
+/*
+ * ===  FUNCTION  ======================================================================
+ *         Name:  writeCacheArray
+ *  Description:  Writes the elements and the padding after them, and adds them to
+ *                the hash in ioHash.
+ * =====================================================================================
+ */
+template <class T>
+static void writeCacheArray (ofstream &outFile, const T *inData, size_t inCount, uint64_t &ioHash) {
+    static const char padding[8] = { 0 };
+    size_t paddingSize = cacheArraySize(inCount, sizeof(T)) - inCount * sizeof(T);
+    outFile.write((const char *)inData, inCount * sizeof(T));
+    outFile.write(padding, paddingSize);
+    ioHash = hashBytes((const char *)inData, inCount * sizeof(T), ioHash);
+    ioHash = hashBytes(padding, paddingSize, ioHash);
+}
+
+/*
+ * ===  FUNCTION  ======================================================================
+ *         Name:  readCacheArray
+ *  Description:  Copies inCount elements from the mapped file into outArray and moves
+ *                ioData past them and their padding.
+ * =====================================================================================
+ */
+template <class T>
+static void readCacheArray (const char *&ioData, size_t inCount, vector <T> &outArray) {
+    const T *firstElement = (const T *)ioData;
+    outArray.assign(firstElement, firstElement + inCount);
+    ioData += cacheArraySize(inCount, sizeof(T));
+}
+
+/*
+ * ===  FUNCTION  ======================================================================
+ *         Name:  isIndexList
+ *  Description:  Returns true if every element is at least inLow and less than inHigh.
+ * =====================================================================================
+ */
+static bool isIndexList (const vector <int> &inList, int inLow, size_t inHigh) {
+    for (int i = 0; i < inList.size(); i++) {
+        if (inList[i] < inLow || inList[i] >= (long long)inHigh)
+            return false;
+    }
+    return true;
+}
+
+/*
+ * ===  FUNCTION  ======================================================================
+ *         Name:  isStartList
+ *  Description:  Returns true if the list starts at 0, never goes down and ends at
+ *                inEnd, so it splits an array of inEnd elements.
+ * =====================================================================================
+ */
+static bool isStartList (const vector <int> &inList, size_t inEnd) {
+    if (inList.empty() || inList[0] != 0 || inList.back() != (long long)inEnd)
+        return false;
+    for (int i = 1; i < inList.size(); i++) {
+        if (inList[i] < inList[i - 1])
+            return false;
+    }
+    return true;
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  CircuitCache
+ *      Method:  CircuitCache :: IsConsistent
+ * Description:  Returns true if every node index, level and fault number in the
+ *               arrays read from a cache file is in range and every line number
+ *               leads to its own node, so a damaged file that still has the right
+ *               size is not used.
+ *--------------------------------------------------------------------------------------
+ */
+bool CircuitCache::IsConsistent (vector <CircuitNode> &inNodeList, CircuitGraph &inGraph, vector <int> &inClassParent) {
+
+    size_t totalNodes = inNodeList.size();
+    if (totalNodes > INT_MAX / 2 || inGraph.maxLevel < 0 || inGraph.levelStart.size() != inGraph.maxLevel + 2)
+        return false;
+
+    if (!isIndexList(inGraph.lineToNode, -1, totalNodes) || !isIndexList(inGraph.sortedNodes, 0, totalNodes))
+        return false;
+    for (int i = 1; i < inGraph.sortedLines.size(); i++) {
+        if (inGraph.sortedLines[i] <= inGraph.sortedLines[i - 1])
+            return false;
+    }
+
+    if (!isStartList(inGraph.fanInStart, inGraph.fanInList.size()) || !isIndexList(inGraph.fanInList, 0, totalNodes) ||
+        !isStartList(inGraph.fanOutStart, inGraph.fanOutList.size()) || !isIndexList(inGraph.fanOutList, 0, totalNodes) ||
+        !isIndexList(inGraph.inputNodes, 0, totalNodes) || !isIndexList(inGraph.outputNodes, 0, totalNodes) ||
+        !isIndexList(inGraph.levelOrder, 0, totalNodes) || !isStartList(inGraph.levelStart, totalNodes) ||
+        !isIndexList(inClassParent, 0, 2 * totalNodes))
+        return false;
+
+    // Every line number has to lead back to its own node, and only those.
+    if (!inGraph.sortedLines.empty() ? (!inGraph.lineToNode.empty() || inGraph.sortedLines.size() != totalNodes) :
+                                       (totalNodes != inGraph.lineToNode.size() - count(inGraph.lineToNode.begin(), inGraph.lineToNode.end(), -1)))
+        return false;
+
+    for (int i = 0; i < totalNodes; i++) {
+        if (inGraph.FindNode(inNodeList[i].lineNumber) != i)
+            return false;
+        if (inNodeList[i].lineLevel < 0 || inNodeList[i].lineLevel > inGraph.maxLevel ||
+            inGraph.fanInStart[i + 1] - inGraph.fanInStart[i] > inGraph.maxFanIn)
+            return false;
+    }
+    return true;
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  CircuitCache
+ *      Method:  CircuitCache :: Save
+ * Description:  Writes the circuit to the file, with the hash of the circuit file.
+ *               Returns false if the file could not be written.
+ *
+ *               The file is written under a temporary name and renamed once it is
+ *               complete, so a run that reads it never sees half a file.
+ *--------------------------------------------------------------------------------------
+ */
+bool CircuitCache::Save (char *inFileName, uint64_t inCircuitHash, bool inDominance) {
+
+    int totalNodes = nodeList.size();
+    int totalFaults = 2 * totalNodes;
+    uint64_t header[CACHE_HEADER_WORDS];
+
+    header[CACHE_MAGIC] = CIRCUIT_CACHE_MAGIC;
+    header[CACHE_VERSION] = CIRCUIT_CACHE_VERSION;
+    header[CACHE_HASH] = inCircuitHash;
+    header[CACHE_DOMINANCE] = inDominance;
+    header[CACHE_NODE_SIZE] = sizeof(CircuitNode);
+    header[CACHE_NODES] = totalNodes;
+    header[CACHE_INPUTS] = graph.inputNodes.size();
+    header[CACHE_OUTPUTS] = graph.outputNodes.size();
+    header[CACHE_LINE_TABLE] = graph.lineToNode.size();
+    header[CACHE_SORTED_LINES] = graph.sortedLines.size();
+    header[CACHE_FAN_INS] = graph.fanInList.size();
+    header[CACHE_FAN_OUTS] = graph.fanOutList.size();
+    header[CACHE_LEVEL_STARTS] = graph.levelStart.size();
+    header[CACHE_MAX_FAN_IN] = graph.maxFanIn;
+    header[CACHE_MAX_LEVEL] = graph.maxLevel;
+    header[CACHE_CLASSES] = faultClasses.numberClasses;
+    header[CACHE_TARGETS] = faultClasses.numberTargets;
+    header[CACHE_CHECKSUM] = 0;
+    header[CACHE_FILE_SIZE] = cacheFileSize(header);
+
+    vector <char> isDominating (totalFaults);
+    for (int i = 0; i < totalFaults; i++) {
+        isDominating[i] = faultClasses.isDominating[i];
+    }
+
+    string tempFileName = string(inFileName) + ".tmp";
+    ofstream outFile (tempFileName.c_str(), ofstream::out | ofstream::binary);
+    if (!outFile)
+        return false;
+
+    // The header is written again at the end, with the checksum.
+    uint64_t checksum = HASH_START;
+    outFile.write((const char *)header, sizeof(header));
+    writeCacheArray(outFile, nodeList.data(), totalNodes, checksum);
+    writeCacheArray(outFile, graph.lineToNode.data(), graph.lineToNode.size(), checksum);
+    writeCacheArray(outFile, graph.sortedLines.data(), graph.sortedLines.size(), checksum);
+    writeCacheArray(outFile, graph.sortedNodes.data(), graph.sortedNodes.size(), checksum);
+    writeCacheArray(outFile, graph.fanInStart.data(), totalNodes + 1, checksum);
+    writeCacheArray(outFile, graph.fanInList.data(), graph.fanInList.size(), checksum);
+    writeCacheArray(outFile, graph.fanOutStart.data(), totalNodes + 1, checksum);
+    writeCacheArray(outFile, graph.fanOutList.data(), graph.fanOutList.size(), checksum);
+    writeCacheArray(outFile, graph.inputNodes.data(), graph.inputNodes.size(), checksum);
+    writeCacheArray(outFile, graph.outputNodes.data(), graph.outputNodes.size(), checksum);
+    writeCacheArray(outFile, graph.levelOrder.data(), totalNodes, checksum);
+    writeCacheArray(outFile, graph.levelStart.data(), graph.levelStart.size(), checksum);
+    writeCacheArray(outFile, faultClasses.classParent.data(), totalFaults, checksum);
+    writeCacheArray(outFile, isDominating.data(), totalFaults, checksum);
+    header[CACHE_CHECKSUM] = checksum;
+    outFile.seekp(0);
+    outFile.write((const char *)header, sizeof(header));
+
+    outFile.close();
+    if (outFile.fail() || rename(tempFileName.c_str(), inFileName) != 0) {
+        remove(tempFileName.c_str());
+        return false;
+    }
+    return true;
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  CircuitCache
+ *      Method:  CircuitCache :: Load
+ * Description:  Reads the circuit from the file. Returns false, and changes nothing,
+ *               if the file does not exist or does not match. The sizes in the header
+ *               have to add up to the size of the file, so nothing is read past its
+ *               end. The checksum in the header has to match the contents, and the
+ *               arrays are checked with IsConsistent before they are used.
+ *
+ *               The number of inputs, outputs and nodes that ReadCircuit counts in
+ *               CircuitNode are set too.
+ *--------------------------------------------------------------------------------------
+ */
+bool CircuitCache::Load (char *inFileName, uint64_t inCircuitHash, bool inDominance) {
+
+    size_t fileSize;
+    const char *fileData = mapFile(inFileName, fileSize);
+    if (fileData == NULL)
+        return false;
+
+    const uint64_t *header = (const uint64_t *)fileData;
+    if (fileSize < sizeof(uint64_t) * CACHE_HEADER_WORDS ||
+        header[CACHE_MAGIC] != CIRCUIT_CACHE_MAGIC || header[CACHE_VERSION] != CIRCUIT_CACHE_VERSION ||
+        header[CACHE_HASH] != inCircuitHash || header[CACHE_DOMINANCE] != inDominance ||
+        header[CACHE_NODE_SIZE] != sizeof(CircuitNode) || header[CACHE_FILE_SIZE] != fileSize) {
+        unmapFile(fileData, fileSize);
+        return false;
+    }
+
+    // Every size is checked against the file before they are added up, so the sum
+    // can not wrap around.
+    for (int i = CACHE_NODES; i < CACHE_CHECKSUM; i++) {
+        if (header[i] > fileSize) {
+            unmapFile(fileData, fileSize);
+            return false;
+        }
+    }
+    if (cacheFileSize(header) != fileSize) {
+        unmapFile(fileData, fileSize);
+        return false;
+    }
+
+    size_t headerSize = sizeof(uint64_t) * CACHE_HEADER_WORDS;
+    if (hashBytes(fileData + headerSize, fileSize - headerSize, HASH_START) != header[CACHE_CHECKSUM]) {
+        unmapFile(fileData, fileSize);
+        return false;
+    }
+
+    size_t totalNodes = header[CACHE_NODES];
+    size_t totalFaults = 2 * totalNodes;
+    const char *thisData = fileData + sizeof(uint64_t) * CACHE_HEADER_WORDS;
+    vector <CircuitNode> newNodeList;
+    CircuitGraph newGraph;
+    vector <int> classParent;
+    vector <char> isDominating;
+
+    readCacheArray(thisData, totalNodes, newNodeList);
+    readCacheArray(thisData, header[CACHE_LINE_TABLE], newGraph.lineToNode);
+    readCacheArray(thisData, header[CACHE_SORTED_LINES], newGraph.sortedLines);
+    readCacheArray(thisData, header[CACHE_SORTED_LINES], newGraph.sortedNodes);
+    readCacheArray(thisData, totalNodes + 1, newGraph.fanInStart);
+    readCacheArray(thisData, header[CACHE_FAN_INS], newGraph.fanInList);
+    readCacheArray(thisData, totalNodes + 1, newGraph.fanOutStart);
+    readCacheArray(thisData, header[CACHE_FAN_OUTS], newGraph.fanOutList);
+    readCacheArray(thisData, header[CACHE_INPUTS], newGraph.inputNodes);
+    readCacheArray(thisData, header[CACHE_OUTPUTS], newGraph.outputNodes);
+    readCacheArray(thisData, totalNodes, newGraph.levelOrder);
+    readCacheArray(thisData, header[CACHE_LEVEL_STARTS], newGraph.levelStart);
+    readCacheArray(thisData, totalFaults, classParent);
+    readCacheArray(thisData, totalFaults, isDominating);
+    newGraph.maxFanIn = header[CACHE_MAX_FAN_IN];
+    newGraph.maxLevel = header[CACHE_MAX_LEVEL];
+    int numberClasses = header[CACHE_CLASSES];
+    int numberTargets = header[CACHE_TARGETS];
+    unmapFile(fileData, fileSize);
+
+    if (!IsConsistent(newNodeList, newGraph, classParent))
+        return false;
+
+    nodeList.swap(newNodeList);
+    swap(graph, newGraph);
+    faultClasses.classParent.swap(classParent);
+    faultClasses.isDominating.assign(isDominating.begin(), isDominating.end());
+    faultClasses.numberClasses = numberClasses;
+    faultClasses.numberTargets = numberTargets;
+
+    CircuitNode::totalNodes = totalNodes;
+    CircuitNode::totalInputs = graph.inputNodes.size();
+    CircuitNode::totalOutputs = graph.outputNodes.size();
+
+    return true;
+}
+
+} /* namespace nameSpace_ATPG */
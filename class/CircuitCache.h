@@ -0,0 +1,88 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  CircuitCache.h
+ *
+ *    Description:  The CircuitCache class. This class saves the circuit, once it is
+ *                  read, levelized and its faults collapsed, to a binary file, and
+ *                  loads it back in a later run instead of doing all that again.
+ *
+ *        Version:  1.0
+ *        Created:  12/02/2011
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  Aditya Shevade <aditya.shevade@gmail.com>,
+ *                  Amey Marathe <marathe.amey@gmail.com>,
+ *                  Samik Biswas <samiksb@gmail.com>,
+ *                  Viraj Bhogle <viraj.bhogle@gmail.com>
+ *
+ * =====================================================================================
+ */
+
+#ifndef CIRCUITCACHE_H_
+#define CIRCUITCACHE_H_
+
+namespace nameSpace_ATPG {
+
+
+/*
+ * =====================================================================================
+ *        Class:  CircuitCache
+ *  Description:  The cache file holds the nodes (with their levels and SCOAP values),
+ *                all the arrays of the CircuitGraph and the fault classes, as they are
+ *                in memory. It starts with a header of 64 bit words, see Save, and
+ *                every array after it starts on an 8 byte boundary.
+ *
+ *                The header has the hash of the circuit file the cache was made from,
+ *                CIRCUIT_CACHE_VERSION, the size of a CircuitNode and whether the fault
+ *                classes were built with dominance. A cache that does not match all
+ *                of them, or that is cut short, is not loaded. Neither is one with a
+ *                node index, level or fault number out of range.
+ *
+ *                Load maps the file with mmap and copies every array straight into
+ *                place, so nothing is parsed.
+ * =====================================================================================
+ */
+class CircuitCache {
+    public:
+        /*
+         *--------------------------------------------------------------------------------------
+         *       Class:  CircuitCache
+         *      Method:  CircuitCache :: CircuitCache
+         * Description:  Takes in the node list, the graph and the fault classes that are
+         *               saved from or loaded into.
+         *--------------------------------------------------------------------------------------
+         */
+        CircuitCache (vector <CircuitNode> &inNodeList, CircuitGraph &inGraph, FaultClasses &inFaultClasses);
+
+        /*
+         *--------------------------------------------------------------------------------------
+         *       Class:  CircuitCache
+         *      Method:  CircuitCache :: Save
+         * Description:  Writes the circuit to the file, with the hash of the circuit file.
+         *               Returns false if the file could not be written.
+         *--------------------------------------------------------------------------------------
+         */
+        bool Save (char *inFileName, uint64_t inCircuitHash, bool inDominance);
+
+        /*
+         *--------------------------------------------------------------------------------------
+         *       Class:  CircuitCache
+         *      Method:  CircuitCache :: Load
+         * Description:  Reads the circuit from the file. Returns false, and changes
+         *               nothing, if the file does not exist or does not match.
+         *--------------------------------------------------------------------------------------
+         */
+        bool Load (char *inFileName, uint64_t inCircuitHash, bool inDominance);
+
+    private:
+        vector <CircuitNode>        &nodeList;
+        CircuitGraph                &graph;
+        FaultClasses                &faultClasses;
+
+        bool    IsConsistent (vector <CircuitNode> &inNodeList, CircuitGraph &inGraph, vector <int> &inClassParent);
+};
+
+} /* namespace nameSpace_ATPG */
+#endif /* CIRCUITCACHE_H_ */
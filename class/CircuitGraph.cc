@@ -0,0 +1,337 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  CircuitGraph.cc
+ *
+ *    Description:  This file defines the methods in the CircuitGraph class.
+ *                  This class stores the fan in and fan out of every node as flat
+ *                  arrays of node indices.
+ *
+ *        Version:  1.0
+ *        Created:  12/02/2011
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  Aditya Shevade <aditya.shevade@gmail.com>,
+ *                  Amey Marathe <marathe.amey@gmail.com>,
+ *                  Samik Biswas <samiksb@gmail.com>,
+ *                  Viraj Bhogle <viraj.bhogle@gmail.com>
+ *
+ * =====================================================================================
+ */
+
+#include "CircuitGraph.h"
+
+// Global constants are defined in this file.
+
+#ifndef GLOBAL_DEFINES_H_
+#include "../include/global_defines.h"
+#endif
+
+namespace nameSpace_ATPG {
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  CircuitGraph
+ *      Method:  CircuitGraph :: Build
+ * Description:  Builds the graph. inFanInLines has the input line numbers of all
+ *               the nodes, one node after the other, numberFanIn lines for each
+ *               node. The program exits if an input line does not exist in the
+ *               circuit or if two nodes have the same line number.
+ *--------------------------------------------------------------------------------------
+ */
+void CircuitGraph::Build (vector <CircuitNode> &inNodeList, vector <unsigned int> &inFanInLines) {
+
+    int totalNodes = inNodeList.size();
+    unsigned int maxLineNumber = 0;
+
+    for (int i = 0; i < totalNodes; i++) {
+        if (inNodeList[i].lineNumber > maxLineNumber)
+            maxLineNumber = inNodeList[i].lineNumber;
+    }
+
+    lineToNode.clear();
+    sortedLines.clear();
+    sortedNodes.clear();
+    if (maxLineNumber / LINE_TABLE_FACTOR < (unsigned int)totalNodes) {
+        lineToNode.assign(maxLineNumber + 1, -1);
+        for (int i = 0; i < totalNodes; i++) {
+            if (lineToNode[inNodeList[i].lineNumber] != -1) {
+                cerr << "ERROR: Line number " << inNodeList[i].lineNumber << " is used by more than one node." << endl;
+                exit (1);
+            }
+            lineToNode[inNodeList[i].lineNumber] = i;
+        }
+    } else {
+        // Line numbers far apart, sort them instead.
+        vector < pair <unsigned int, int> > lineNodes (totalNodes);
+        for (int i = 0; i < totalNodes; i++) {
+            lineNodes[i] = make_pair(inNodeList[i].lineNumber, i);
+        }
+        sort(lineNodes.begin(), lineNodes.end());
+        sortedLines.resize(totalNodes);
+        sortedNodes.resize(totalNodes);
+        for (int i = 0; i < totalNodes; i++) {
+            if (i > 0 && lineNodes[i].first == lineNodes[i - 1].first) {
+                cerr << "ERROR: Line number " << lineNodes[i].first << " is used by more than one node." << endl;
+                exit (1);
+            }
+            sortedLines[i] = lineNodes[i].first;
+            sortedNodes[i] = lineNodes[i].second;
+        }
+    }
+
+    // Fan in. The inputs are read in the same order as in the circuit file.
+    fanInStart.assign(totalNodes + 1, 0);
+    fanInList.resize(inFanInLines.size());
+    maxFanIn = 1;
+    for (int i = 0, k = 0; i < totalNodes; i++) {
+        fanInStart[i] = k;
+        for (int j = 0; j < inNodeList[i].numberFanIn; j++, k++) {
+            int inputNode = FindNode(inFanInLines[k]);
+            if (inputNode < 0) {
+                cerr << "ERROR: Line number " << inFanInLines[k] << " is an input to line "
+                     << inNodeList[i].lineNumber << " but does not exist in the circuit." << endl;
+                exit (1);
+            }
+            fanInList[k] = inputNode;
+        }
+        if (inNodeList[i].numberFanIn > maxFanIn)
+            maxFanIn = inNodeList[i].numberFanIn;
+    }
+    fanInStart[totalNodes] = fanInList.size();
+
+    // Fan out. First count the outputs of each node, then fill them in.
+    fanOutStart.assign(totalNodes + 1, 0);
+    fanOutList.resize(fanInList.size());
+    for (int k = 0; k < fanInList.size(); k++) {
+        fanOutStart[fanInList[k] + 1]++;
+    }
+    for (int i = 0; i < totalNodes; i++) {
+        fanOutStart[i + 1] += fanOutStart[i];
+    }
+    vector <int> nextFanOut (fanOutStart.begin(), fanOutStart.end() - 1);
+    for (int i = 0; i < totalNodes; i++) {
+        for (int k = fanInStart[i]; k < fanInStart[i + 1]; k++) {
+            fanOutList[nextFanOut[fanInList[k]]++] = i;
+        }
+    }
+
+    inputNodes.clear();
+    outputNodes.clear();
+    for (int i = 0; i < totalNodes; i++) {
+        if (inNodeList[i].numberFanIn == 0)
+            inputNodes.push_back(i);
+        if (inNodeList[i].numberFanOut == 0)
+            outputNodes.push_back(i);
+    }
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  CircuitGraph
+ *      Method:  CircuitGraph :: Levelize
+ * Description:  Sets the lineLevel of every node, 0 for the primary inputs and one
+ *               more than the highest input level for every other node, and fills
+ *               levelOrder and levelStart. The program exits if the circuit has
+ *               a combinational loop.
+ *
+ *               A node gets its level once all its inputs have one, so every node
+ *               and every connection is looked at only once. Nodes on a loop never
+ *               get a level.
+ *--------------------------------------------------------------------------------------
+ */
+void CircuitGraph::Levelize (vector <CircuitNode> &inNodeList) {
+
+    int totalNodes = inNodeList.size();
+    vector <int> pendingInputs (totalNodes);
+    vector <int> readyNodes;
+
+    for (int i = 0; i < totalNodes; i++) {
+        inNodeList[i].lineLevel = 0;
+        pendingInputs[i] = fanInStart[i + 1] - fanInStart[i];
+        if (pendingInputs[i] == 0)
+            readyNodes.push_back(i);
+    }
+
+    maxLevel = 0;
+    for (int i = 0; i < readyNodes.size(); i++) {
+        int thisNode = readyNodes[i];
+        int nextLevel = inNodeList[thisNode].lineLevel + 1;
+        for (int k = fanOutStart[thisNode]; k < fanOutStart[thisNode + 1]; k++) {
+            int nextNode = fanOutList[k];
+            if (inNodeList[nextNode].lineLevel < nextLevel)
+                inNodeList[nextNode].lineLevel = nextLevel;
+            if (--pendingInputs[nextNode] == 0)
+                readyNodes.push_back(nextNode);
+        }
+        if (inNodeList[thisNode].lineLevel > maxLevel)
+            maxLevel = inNodeList[thisNode].lineLevel;
+    }
+
+    if (readyNodes.size() < totalNodes) {
+        // Every node left has an input that is also left, so going back through
+        // such inputs must come around to a node already seen.
+        vector <int> pathPosition (totalNodes, -1);
+        vector <int> loopPath;
+        int thisNode = 0;
+        while (pendingInputs[thisNode] == 0)
+            thisNode++;
+        while (pathPosition[thisNode] < 0) {
+            pathPosition[thisNode] = loopPath.size();
+            loopPath.push_back(thisNode);
+            for (int k = fanInStart[thisNode]; k < fanInStart[thisNode + 1]; k++) {
+                if (pendingInputs[fanInList[k]] > 0) {
+                    thisNode = fanInList[k];
+                    break;
+                }
+            }
+        }
+
+        cerr << "ERROR: The circuit has a combinational loop." << endl
+             << "The loop goes through the line numbers";
+        for (int i = loopPath.size() - 1; i >= pathPosition[thisNode]; i--) {
+            cerr << " " << inNodeList[loopPath[i]].lineNumber;
+        }
+        cerr << " " << inNodeList[loopPath.back()].lineNumber << "." << endl;
+        exit (1);
+    }
+
+    // Sort the nodes by level. Within a level the nodes stay in node list order.
+    levelStart.assign(maxLevel + 2, 0);
+    for (int i = 0; i < totalNodes; i++) {
+        levelStart[inNodeList[i].lineLevel + 1]++;
+    }
+    for (int level = 0; level <= maxLevel; level++) {
+        levelStart[level + 1] += levelStart[level];
+    }
+    levelOrder.resize(totalNodes);
+    vector <int> nextPosition (levelStart.begin(), levelStart.end() - 1);
+    for (int i = 0; i < totalNodes; i++) {
+        levelOrder[nextPosition[inNodeList[i].lineLevel]++] = i;
+    }
+}
+
+/*
+ * ===  FUNCTION  ======================================================================
+ *         Name:  addScoap
+ *  Description:  Adds two SCOAP values, stopping at SCOAP_LIMIT.
+ * =====================================================================================
+ */
+static unsigned int addScoap (unsigned int inFirst, unsigned int inSecond) {
+    return (inFirst + inSecond > SCOAP_LIMIT ? SCOAP_LIMIT : inFirst + inSecond);
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  CircuitGraph
+ *      Method:  CircuitGraph :: ComputeTestability
+ * Description:  Sets the SCOAP values cc0, cc1 and co of every node. The circuit
+ *               must already be levelized.
+ *
+ *               The controllabilities go forward in level order. A primary input
+ *               costs 1 either way, and every gate adds 1 to the cheapest way to
+ *               set its output. A branch costs the same as its stem.
+ *
+ *               The observabilities go backward. A primary output costs 0. An input
+ *               of a gate costs the observability of the gate, plus what it takes
+ *               to set the other inputs to values that let it through, plus 1. A
+ *               node with several fan outs (a stem) takes the cheapest of them.
+ *--------------------------------------------------------------------------------------
+ */
+void CircuitGraph::ComputeTestability (vector <CircuitNode> &inNodeList) {
+
+    for (int i = 0; i < levelOrder.size(); i++) {
+        CircuitNode &thisNode = inNodeList[levelOrder[i]];
+        int firstInput = fanInStart[levelOrder[i]];
+        int numberInputs = fanInStart[levelOrder[i] + 1] - firstInput;
+
+        if (numberInputs == 0) {
+            thisNode.cc0 = 1;
+            thisNode.cc1 = 1;
+            continue;
+        }
+
+        // allZero and allOne are the costs of setting every input to 0 or to 1,
+        // anyZero and anyOne of setting at least one. parityZero and parityOne are
+        // the costs of an even or odd number of inputs at 1.
+        unsigned int allZero = 0, allOne = 0, anyZero = SCOAP_LIMIT, anyOne = SCOAP_LIMIT;
+        unsigned int parityZero = 0, parityOne = SCOAP_LIMIT;
+        for (int j = firstInput; j < firstInput + numberInputs; j++) {
+            CircuitNode &inputNode = inNodeList[fanInList[j]];
+            allZero = addScoap(allZero, inputNode.cc0);
+            allOne = addScoap(allOne, inputNode.cc1);
+            anyZero = min(anyZero, inputNode.cc0);
+            anyOne = min(anyOne, inputNode.cc1);
+            unsigned int nextZero = min(addScoap(parityZero, inputNode.cc0), addScoap(parityOne, inputNode.cc1));
+            unsigned int nextOne = min(addScoap(parityZero, inputNode.cc1), addScoap(parityOne, inputNode.cc0));
+            parityZero = nextZero;
+            parityOne = nextOne;
+        }
+
+        switch (thisNode.gateType) {
+            case BRNCH:
+                thisNode.cc0 = allZero;
+                thisNode.cc1 = allOne;
+                break;
+            case INV:
+                thisNode.cc0 = addScoap(allOne, 1);
+                thisNode.cc1 = addScoap(allZero, 1);
+                break;
+            case AND:
+                thisNode.cc0 = addScoap(anyZero, 1);
+                thisNode.cc1 = addScoap(allOne, 1);
+                break;
+            case NAND:
+                thisNode.cc0 = addScoap(allOne, 1);
+                thisNode.cc1 = addScoap(anyZero, 1);
+                break;
+            case OR:
+                thisNode.cc0 = addScoap(allZero, 1);
+                thisNode.cc1 = addScoap(anyOne, 1);
+                break;
+            case NOR:
+                thisNode.cc0 = addScoap(anyOne, 1);
+                thisNode.cc1 = addScoap(allZero, 1);
+                break;
+            case XOR:
+                thisNode.cc0 = addScoap(parityZero, 1);
+                thisNode.cc1 = addScoap(parityOne, 1);
+                break;
+            default:                                    // XNOR.
+                thisNode.cc0 = addScoap(parityOne, 1);
+                thisNode.cc1 = addScoap(parityZero, 1);
+                break;
+        }
+    }
+
+    for (int i = levelOrder.size() - 1; i >= 0; i--) {
+        int thisNode = levelOrder[i];
+        unsigned int bestCost = (fanOutStart[thisNode + 1] == fanOutStart[thisNode] ? 0 : SCOAP_LIMIT);
+
+        // Every fan out comes earlier in this order, so its co is already set.
+        for (int k = fanOutStart[thisNode]; k < fanOutStart[thisNode + 1]; k++) {
+            int nextNode = fanOutList[k];
+            unsigned int gateType = inNodeList[nextNode].gateType;
+            unsigned int thisCost = inNodeList[nextNode].co;
+
+            if (gateType != BRNCH)
+                thisCost = addScoap(thisCost, 1);
+            for (int j = fanInStart[nextNode]; j < fanInStart[nextNode + 1]; j++) {
+                CircuitNode &otherNode = inNodeList[fanInList[j]];
+                if (fanInList[j] == thisNode)
+                    continue;
+                if (gateType == AND || gateType == NAND)
+                    thisCost = addScoap(thisCost, otherNode.cc1);
+                else if (gateType == OR || gateType == NOR)
+                    thisCost = addScoap(thisCost, otherNode.cc0);
+                else
+                    thisCost = addScoap(thisCost, min(otherNode.cc0, otherNode.cc1));
+            }
+            bestCost = min(bestCost, thisCost);
+        }
+        inNodeList[thisNode].co = bestCost;
+    }
+}
+
+} /* namespace nameSpace_ATPG */
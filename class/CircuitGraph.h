@@ -0,0 +1,128 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  CircuitGraph.h
+ *
+ *    Description:  The CircuitGraph class. This class stores the connections between
+ *                  the nodes of the circuit in a form that is fast to walk through.
+ *
+ *                  Line numbers are mapped to node indices with a table, and the fan
+ *                  in and fan out of all the nodes are kept in two flat arrays
+ *                  (compressed sparse rows).
+ *
+ *        Version:  1.0
+ *        Created:  12/02/2011
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  Aditya Shevade <aditya.shevade@gmail.com>,
+ *                  Amey Marathe <marathe.amey@gmail.com>,
+ *                  Samik Biswas <samiksb@gmail.com>,
+ *                  Viraj Bhogle <viraj.bhogle@gmail.com>
+ *
+ * =====================================================================================
+ */
+
+#ifndef CIRCUITGRAPH_H_
+#define CIRCUITGRAPH_H_
+
+namespace nameSpace_ATPG {
+
+
+/*
+ * =====================================================================================
+ *        Class:  CircuitGraph
+ *  Description:  All the members refer to nodes by their index in the node list.
+ *
+ *                Line numbers are found with a table indexed by the line number,
+ *                lineToNode, as long as the largest line number is less than
+ *                LINE_TABLE_FACTOR times the number of nodes. Otherwise the table
+ *                would be mostly empty, and the line numbers are kept sorted in
+ *                sortedLines instead, with their nodes in sortedNodes, and searched.
+ *
+ *                The fan in of node i is fanInList[fanInStart[i]] up to (but not
+ *                including) fanInList[fanInStart[i + 1]], in the order the inputs
+ *                are given in the circuit file. The fan out is stored the same way
+ *                in fanOutStart and fanOutList.
+ *
+ *                The nodes of level L are levelOrder[levelStart[L]] up to (but not
+ *                including) levelOrder[levelStart[L + 1]], in node list order, so
+ *                levelOrder is also an order in which the circuit can be evaluated.
+ *
+ *                The graph is built once, after the circuit file is read, and
+ *                levelized once. It is only read after that.
+ * =====================================================================================
+ */
+class CircuitGraph {
+    public:
+        vector <int>    lineToNode;     // Node index for each line number, -1 if no node.
+        vector <unsigned int> sortedLines;  // All the line numbers, sorted, if lineToNode is empty.
+        vector <int>    sortedNodes;    // Node index of each line number in sortedLines.
+        vector <int>    fanInStart;     // Start of the fan in of each node in fanInList.
+        vector <int>    fanInList;      // Fan in of all the nodes.
+        vector <int>    fanOutStart;    // Start of the fan out of each node in fanOutList.
+        vector <int>    fanOutList;     // Fan out of all the nodes.
+        vector <int>    inputNodes;     // Primary inputs, in the order of the input vector.
+        vector <int>    outputNodes;    // Primary outputs.
+                int     maxFanIn;       // Largest number of inputs to any node.
+        vector <int>    levelOrder;     // All the nodes, by level.
+        vector <int>    levelStart;     // Start of each level in levelOrder.
+                int     maxLevel;       // Highest level in the circuit.
+
+        /*
+         *--------------------------------------------------------------------------------------
+         *       Class:  CircuitGraph
+         *      Method:  CircuitGraph :: Build
+         * Description:  Builds the graph. inFanInLines has the input line numbers of all
+         *               the nodes, one node after the other, numberFanIn lines for each
+         *               node. The program exits if an input line does not exist in the
+         *               circuit or if two nodes have the same line number.
+         *--------------------------------------------------------------------------------------
+         */
+        void Build (vector <CircuitNode> &inNodeList, vector <unsigned int> &inFanInLines);
+
+        /*
+         *--------------------------------------------------------------------------------------
+         *       Class:  CircuitGraph
+         *      Method:  CircuitGraph :: Levelize
+         * Description:  Sets the lineLevel of every node, 0 for the primary inputs and one
+         *               more than the highest input level for every other node, and fills
+         *               levelOrder and levelStart. The program exits if the circuit has
+         *               a combinational loop.
+         *--------------------------------------------------------------------------------------
+         */
+        void Levelize (vector <CircuitNode> &inNodeList);
+
+        /*
+         *--------------------------------------------------------------------------------------
+         *       Class:  CircuitGraph
+         *      Method:  CircuitGraph :: ComputeTestability
+         * Description:  Sets the SCOAP values cc0, cc1 and co of every node. The circuit
+         *               must already be levelized.
+         *--------------------------------------------------------------------------------------
+         */
+        void ComputeTestability (vector <CircuitNode> &inNodeList);
+
+        /*
+         *--------------------------------------------------------------------------------------
+         *       Class:  CircuitGraph
+         *      Method:  CircuitGraph :: FindNode
+         * Description:  Returns the node index of the given line number, -1 if the line is
+         *               not in the circuit.
+         *--------------------------------------------------------------------------------------
+         */
+        int FindNode (unsigned int inLineNumber) {
+            if (!sortedLines.empty()) {
+                vector <unsigned int>::iterator itr = lower_bound(sortedLines.begin(), sortedLines.end(), inLineNumber);
+                if (itr == sortedLines.end() || *itr != inLineNumber)
+                    return -1;
+                return sortedNodes[itr - sortedLines.begin()];
+            }
+            if (inLineNumber >= lineToNode.size())
+                return -1;
+            return lineToNode[inLineNumber];
+        }
+};
+
+} /* namespace nameSpace_ATPG */
+#endif /* CIRCUITGRAPH_H_ */
@@ -49,6 +49,8 @@ CircuitNode::CircuitNode(int inNodeType) {
         totalOutputs ++;            // Total number of outputs from circuit.
 
     this->nodeIndex = totalNodes;   // Set the node ID of current object.
+    this->lineValue = V_X;          // Not simulated yet.
+    this->cc0 = this->cc1 = this->co = SCOAP_LIMIT;  // Not analysed yet.
 }
 
 /*
@@ -36,21 +36,23 @@ namespace nameSpace_ATPG {
  *                a Logic Gate.
  *
  *                There are a number of properties associated with each circuit line.
- *                All such properties are included below.
+ *                All such properties are included below. The inputs and outputs of
+ *                the node are kept in the CircuitGraph, so the node itself is small.
  * =====================================================================================
  */
 class CircuitNode {
     public:
         unsigned    int     nodeIndex;      // Node ID, unique.
-        unsigned    int     nodeType;       // Type of the node.
         unsigned    int     lineNumber;     // Unique line number.
-        unsigned    int     gateType;       // Type of the gate if the node is gate.
         unsigned    int     numberFanIn;    // Total inputs to this node.
         unsigned    int     numberFanOut;   // Total outputs from this node.
-        set         <int>   listFanIn;      // List of inputs to this node.
-        set         <int>   listFanOut;     // List of outputs from this node.
                     int     lineLevel;      // Level of the line (after levelization).
-        set         <int>   lineValue;      // Value of the line (for simulation).
+        unsigned    char    nodeType;       // Type of the node.
+        unsigned    char    gateType;       // Type of the gate if the node is gate.
+        unsigned    char    lineValue;      // Packed value of the line (for simulation).
+        unsigned    int     cc0;            // SCOAP 0 controllability.
+        unsigned    int     cc1;            // SCOAP 1 controllability.
+        unsigned    int     co;             // SCOAP observability.
 
         static      int     totalNodes;     // Number of nodes, global.
         static      int     totalInputs;    // Number of primary inputs, global.
@@ -0,0 +1,248 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  ConcurrentSimulator.cc
+ *
+ *    Description:  This file defines the methods in the ConcurrentSimulator class.
+ *                  The class grades test vectors against stuck at faults, one vector
+ *                  at a time, keeping a list of the faulty values on every line.
+ *
+ *        Version:  1.0
+ *        Created:  12/02/2011
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  Aditya Shevade <aditya.shevade@gmail.com>,
+ *                  Amey Marathe <marathe.amey@gmail.com>,
+ *                  Samik Biswas <samiksb@gmail.com>,
+ *                  Viraj Bhogle <viraj.bhogle@gmail.com>
+ *
+ * =====================================================================================
+ */
+
+#include "ConcurrentSimulator.h"
+
+// Global constants are defined in this file.
+
+#ifndef GLOBAL_DEFINES_H_
+#include "../include/global_defines.h"
+#endif
+
+namespace nameSpace_ATPG {
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  ConcurrentSimulator
+ *      Method:  ConcurrentSimulator :: ConcurrentSimulator
+ * Description:  Takes in the node list of the circuit and its graph. The circuit
+ *               must already be levelized.
+ *--------------------------------------------------------------------------------------
+ */
+ConcurrentSimulator::ConcurrentSimulator (vector <CircuitNode> &inNodeList, CircuitGraph &inGraph) : nodeList (inNodeList), graph (inGraph) {
+
+    int totalNodes = nodeList.size();
+    int maxInputs = 0;
+
+    totalVectors = 0;
+    totalEntries = 0;
+
+    goodOne.assign(totalNodes, 0);
+    goodZero.assign(totalNodes, 0);
+    listStart.assign(totalNodes, 0);
+    listEnd.assign(totalNodes, 0);
+
+    for (int i = 0; i < totalNodes; i++) {
+        if (graph.fanInStart[i + 1] - graph.fanInStart[i] > maxInputs)
+            maxInputs = graph.fanInStart[i + 1] - graph.fanInStart[i];
+    }
+    inputCursor.assign(maxInputs, 0);
+    inputOne.assign(maxInputs, 0);
+    inputZero.assign(maxInputs, 0);
+    for (int j = 0; j < maxInputs; j++) {
+        inputIndex.push_back(j);
+    }
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  ConcurrentSimulator
+ *      Method:  ConcurrentSimulator :: LoadVector
+ * Description:  Sets the primary inputs to the vector. Missing positions and any
+ *               character other than 0 or 1 are X.
+ *--------------------------------------------------------------------------------------
+ */
+void ConcurrentSimulator::LoadVector (string &inVector) {
+
+    for (int i = 0; i < graph.inputNodes.size(); i++) {
+        int thisNode = graph.inputNodes[i];
+        goodOne[thisNode] = (i < inVector.length() && inVector[i] == '1');
+        goodZero[thisNode] = (i < inVector.length() && inVector[i] == '0');
+    }
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  ConcurrentSimulator
+ *      Method:  ConcurrentSimulator :: SimulateGoodCircuit
+ * Description:  Simulates the fault free circuit for the loaded vector.
+ *--------------------------------------------------------------------------------------
+ */
+void ConcurrentSimulator::SimulateGoodCircuit () {
+
+    for (int i = 0; i < graph.levelOrder.size(); i++) {
+        int thisNode = graph.levelOrder[i];
+        int firstInput = graph.fanInStart[thisNode];
+        int numberInputs = graph.fanInStart[thisNode + 1] - firstInput;
+        if (numberInputs == 0)
+            continue;
+        evaluateGateParallel (nodeList[thisNode].gateType, &goodOne[0], &goodZero[0], &graph.fanInList[firstInput],
+                              numberInputs, goodOne[thisNode], goodZero[thisNode]);
+    }
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  ConcurrentSimulator
+ *      Method:  ConcurrentSimulator :: SimulateFaults
+ * Description:  Makes the fault list of every node, in level order, for the loaded
+ *               vector. The active faults that reach a primary output with a known
+ *               value, different from the fault free one, are added to
+ *               outDetectedFaults and made inactive.
+ *
+ *               The list of a node is a merge of the lists of its inputs. A fault
+ *               found in some of them is evaluated with the faulty values on those
+ *               inputs and the fault free values on the rest. A fault on the node
+ *               itself is added when the vector excites it, with the stuck at value.
+ *--------------------------------------------------------------------------------------
+ */
+void ConcurrentSimulator::SimulateFaults (vector <FaultList> &inFaultList, vector <int> &outDetectedFaults) {
+
+    int noFault = inFaultList.size();
+
+    faultEntry.clear();
+    outDetectedFaults.clear();
+    for (int i = 0; i < graph.levelOrder.size(); i++) {
+        int thisNode = graph.levelOrder[i];
+        int firstInput = graph.fanInStart[thisNode];
+        int numberInputs = graph.fanInStart[thisNode + 1] - firstInput;
+        int thisSite = siteStart[thisNode];
+        uint64_t thisGoodOne = goodOne[thisNode];
+        uint64_t thisGoodZero = goodZero[thisNode];
+
+        for (int j = 0; j < numberInputs; j++) {
+            inputCursor[j] = listStart[graph.fanInList[firstInput + j]];
+        }
+        listStart[thisNode] = faultEntry.size();
+
+        while (true) {
+            // The next fault is the lowest index left in the input lists or on the node.
+            int thisFault = noFault;
+            for (int j = 0; j < numberInputs; j++) {
+                int inputNode = graph.fanInList[firstInput + j];
+                if (inputCursor[j] < listEnd[inputNode] && faultEntry[inputCursor[j]].faultIndex < thisFault)
+                    thisFault = faultEntry[inputCursor[j]].faultIndex;
+            }
+            while (thisSite < siteStart[thisNode + 1] && !isActive[siteFaults[thisSite]])
+                thisSite++;
+            bool isSiteFault = (thisSite < siteStart[thisNode + 1] && siteFaults[thisSite] <= thisFault);
+            if (isSiteFault)
+                thisFault = siteFaults[thisSite++];
+            if (thisFault == noFault)
+                break;
+
+            uint64_t newOne, newZero;
+            if (isSiteFault) {
+                // Only excited faults are injected, so the others are never detected.
+                bool stuckAtValue = inFaultList[thisFault].stuckAtValue;
+                if ((stuckAtValue ? thisGoodZero : thisGoodOne) == 0)
+                    continue;
+                newOne = stuckAtValue;
+                newZero = !stuckAtValue;
+            }
+            else {
+                for (int j = 0; j < numberInputs; j++) {
+                    int inputNode = graph.fanInList[firstInput + j];
+                    if (inputCursor[j] < listEnd[inputNode] && faultEntry[inputCursor[j]].faultIndex == thisFault) {
+                        inputOne[j] = faultEntry[inputCursor[j]].faultValue & 1;
+                        inputZero[j] = faultEntry[inputCursor[j]].faultValue >> 1;
+                        inputCursor[j]++;
+                    }
+                    else {
+                        inputOne[j] = goodOne[inputNode];
+                        inputZero[j] = goodZero[inputNode];
+                    }
+                }
+                evaluateGateParallel (nodeList[thisNode].gateType, &inputOne[0], &inputZero[0], &inputIndex[0],
+                                      numberInputs, newOne, newZero);
+                if (newOne == thisGoodOne && newZero == thisGoodZero)
+                    continue;
+            }
+
+            FaultEntry newEntry;
+            newEntry.faultIndex = thisFault;
+            newEntry.faultValue = newOne | (newZero << 1);
+            faultEntry.push_back(newEntry);
+
+            if (nodeList[thisNode].numberFanOut == 0 && isActive[thisFault] &&
+                ((thisGoodOne & newZero) | (thisGoodZero & newOne))) {
+                isActive[thisFault] = false;
+                outDetectedFaults.push_back(thisFault);
+            }
+        }
+        listEnd[thisNode] = faultEntry.size();
+    }
+    totalEntries += faultEntry.size();
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  ConcurrentSimulator
+ *      Method:  ConcurrentSimulator :: GradeVectors
+ * Description:  Simulates the vectors one after the other against all the faults.
+ *               For every fault, outDetectingVector has the index of the first
+ *               vector in the list that detects it, or -1 if no vector detects it.
+ *               A fault is not simulated any more once it is detected.
+ *--------------------------------------------------------------------------------------
+ */
+void ConcurrentSimulator::GradeVectors (vector <string> &inVectorList, vector <FaultList> &inFaultList, vector <int> &outDetectingVector) {
+
+    int totalNodes = nodeList.size();
+    vector <int> faultNode (inFaultList.size(), -1);
+    vector <int> detectedFaults;
+
+    outDetectingVector.assign(inFaultList.size(), -1);
+
+    // The faults are sorted by node, and by index within a node.
+    siteStart.assign(totalNodes + 1, 0);
+    for (int i = 0; i < inFaultList.size(); i++) {
+        faultNode[i] = graph.FindNode(inFaultList[i].lineNumber);
+        if (faultNode[i] >= 0)
+            siteStart[faultNode[i] + 1]++;
+    }
+    for (int i = 0; i < totalNodes; i++) {
+        siteStart[i + 1] += siteStart[i];
+    }
+    siteFaults.assign(siteStart[totalNodes], 0);
+    vector <int> siteFill (siteStart.begin(), siteStart.end() - 1);
+    for (int i = 0; i < inFaultList.size(); i++) {
+        if (faultNode[i] >= 0)
+            siteFaults[siteFill[faultNode[i]]++] = i;
+    }
+
+    isActive.assign(inFaultList.size(), true);
+    int numberRemaining = siteStart[totalNodes];
+
+    for (int v = 0; v < inVectorList.size() && numberRemaining > 0; v++) {
+        LoadVector(inVectorList[v]);
+        SimulateGoodCircuit();
+        SimulateFaults(inFaultList, detectedFaults);
+        totalVectors++;
+
+        for (int i = 0; i < detectedFaults.size(); i++) {
+            outDetectingVector[detectedFaults[i]] = v;
+        }
+        numberRemaining -= detectedFaults.size();
+    }
+}
+
+} /* namespace nameSpace_ATPG */
@@ -0,0 +1,111 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  ConcurrentSimulator.h
+ *
+ *    Description:  The ConcurrentSimulator class. This class grades a list of test
+ *                  vectors against a list of stuck at faults, one vector at a time
+ *                  and all the faults at once.
+ *
+ *                  It is a concurrent fault simulator. For every line it keeps only
+ *                  the faults whose faulty value differs from the fault free value on
+ *                  that line, so a vector is handled in one pass over the circuit
+ *                  whatever the number of faults.
+ *
+ *        Version:  1.0
+ *        Created:  12/02/2011
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  Aditya Shevade <aditya.shevade@gmail.com>,
+ *                  Amey Marathe <marathe.amey@gmail.com>,
+ *                  Samik Biswas <samiksb@gmail.com>,
+ *                  Viraj Bhogle <viraj.bhogle@gmail.com>
+ *
+ * =====================================================================================
+ */
+
+#ifndef CONCURRENTSIMULATOR_H_
+#define CONCURRENTSIMULATOR_H_
+
+namespace nameSpace_ATPG {
+
+
+/*
+ * =====================================================================================
+ *        Class:  ConcurrentSimulator
+ *  Description:  Values are kept as in the FaultSimulator, a ONE bit and a ZERO bit,
+ *                neither of them set for X, but for one vector only.
+ *
+ *                The fault list of a line is a run of entries (fault index, faulty
+ *                value) in faultEntry, sorted by fault index. The lists are made in
+ *                level order, so the list of a gate is a merge of the lists of its
+ *                inputs, plus the faults on the gate output itself. A fault only gets
+ *                an entry where its value differs from the fault free value, so the
+ *                lists stay short when the fault effects die out.
+ *
+ *                The detection results are the same as FaultSimulator :: GradeVectors.
+ * =====================================================================================
+ */
+class ConcurrentSimulator {
+    public:
+        unsigned    long    totalVectors;       // Vectors simulated.
+        unsigned    long    totalEntries;       // Fault list entries made, all vectors.
+
+        /*
+         *--------------------------------------------------------------------------------------
+         *       Class:  ConcurrentSimulator
+         *      Method:  ConcurrentSimulator :: ConcurrentSimulator
+         * Description:  Takes in the node list of the circuit and its graph. The circuit
+         *               must already be levelized.
+         *--------------------------------------------------------------------------------------
+         */
+        ConcurrentSimulator (vector <CircuitNode> &inNodeList, CircuitGraph &inGraph);
+
+        /*
+         *--------------------------------------------------------------------------------------
+         *       Class:  ConcurrentSimulator
+         *      Method:  ConcurrentSimulator :: GradeVectors
+         * Description:  Simulates the vectors one after the other against all the faults.
+         *               For every fault, outDetectingVector has the index of the first
+         *               vector in the list that detects it, or -1 if no vector detects
+         *               it. A fault is not simulated any more once it is detected.
+         *--------------------------------------------------------------------------------------
+         */
+        void GradeVectors (vector <string> &inVectorList, vector <FaultList> &inFaultList, vector <int> &outDetectingVector);
+
+    private:
+        /*
+         * One entry of a fault list.
+         */
+        struct FaultEntry {
+            int             faultIndex;     // Index in the fault list.
+            unsigned char   faultValue;     // Bit 0 set for 1, bit 1 set for 0.
+        };
+
+        vector <CircuitNode>        &nodeList;      // The circuit, read only.
+        CircuitGraph                &graph;         // Fan in and fan out of the nodes, read only.
+
+        vector <uint64_t>           goodOne;        // Fault free values, bit 0 only.
+        vector <uint64_t>           goodZero;
+
+        vector <int>                siteStart;      // Faults on each node, in siteFaults.
+        vector <int>                siteFaults;     // Indices of the faults, by node.
+        vector <bool>               isActive;       // False once a fault is detected.
+
+        vector <int>                listStart;      // Start of the fault list of each node.
+        vector <int>                listEnd;        // End of the fault list of each node.
+        vector <FaultEntry>         faultEntry;     // All the fault lists of the current vector.
+
+        vector <int>                inputCursor;    // Merge position in each input list.
+        vector <uint64_t>           inputOne;       // Input values for one faulty gate.
+        vector <uint64_t>           inputZero;
+        vector <int>                inputIndex;     // 0, 1, 2, ... for the evaluation.
+
+        void    LoadVector (string &inVector);
+        void    SimulateGoodCircuit ();
+        void    SimulateFaults (vector <FaultList> &inFaultList, vector <int> &outDetectedFaults);
+};
+
+} /* namespace nameSpace_ATPG */
+#endif /* CONCURRENTSIMULATOR_H_ */
@@ -0,0 +1,187 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  FaultClasses.cc
+ *
+ *    Description:  This file defines the methods in the FaultClasses class.
+ *                  The class groups the faults of the circuit into equivalence classes.
+ *
+ *        Version:  1.0
+ *        Created:  12/02/2011
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  Aditya Shevade <aditya.shevade@gmail.com>,
+ *                  Amey Marathe <marathe.amey@gmail.com>,
+ *                  Samik Biswas <samiksb@gmail.com>,
+ *                  Viraj Bhogle <viraj.bhogle@gmail.com>
+ *
+ * =====================================================================================
+ */
+
+#include "FaultClasses.h"
+
+// Global constants are defined in this file.
+
+#ifndef GLOBAL_DEFINES_H_
+#include "../include/global_defines.h"
+#endif
+
+namespace nameSpace_ATPG {
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  FaultClasses
+ *      Method:  FaultClasses :: Build
+ * Description:  Builds the classes for all the faults in the circuit. The faults
+ *               that dominate others are also marked if inDominance is true.
+ *--------------------------------------------------------------------------------------
+ */
+void FaultClasses::Build (vector <CircuitNode> &inNodeList, CircuitGraph &inGraph, bool inDominance) {
+
+    int totalFaults = 2 * inNodeList.size();
+
+    classParent.resize(totalFaults);
+    for (int i = 0; i < totalFaults; i++) {
+        classParent[i] = i;
+    }
+    isDominating.assign(totalFaults, false);
+
+    for (int j = 0; j < inNodeList.size(); j++) {
+        int firstFanIn = inGraph.fanInStart[j];
+        int numberInputs = inGraph.fanInStart[j + 1] - firstFanIn;
+        if (numberInputs == 0)
+            continue;
+
+        // Stuck at value of the input faults that are joined with the output, and
+        // whether the gate inverts. 2 means both values, -1 means no rule.
+        int inputValue = -1;
+        bool isInverting = false;
+        switch (inNodeList[j].gateType) {
+            case G_BRNCH:
+                inputValue = 2;
+                break;
+            case G_AND:
+                inputValue = (numberInputs == 1 ? 2 : 0);
+                break;
+            case G_NAND:
+                inputValue = (numberInputs == 1 ? 2 : 0);
+                isInverting = true;
+                break;
+            case G_OR:
+                inputValue = (numberInputs == 1 ? 2 : 1);
+                break;
+            case G_NOR:
+                inputValue = (numberInputs == 1 ? 2 : 1);
+                isInverting = true;
+                break;
+            case G_NOT:
+                inputValue = 2;
+                isInverting = true;
+                break;
+            case G_XOR:
+                inputValue = (numberInputs == 1 ? 2 : -1);
+                break;
+            case G_XNOR:
+                inputValue = (numberInputs == 1 ? 2 : -1);
+                isInverting = true;
+                break;
+            default:
+                break;
+        }
+        if (inputValue < 0)
+            continue;
+
+        for (int k = firstFanIn; k < firstFanIn + numberInputs; k++) {
+            int inNode = inGraph.fanInList[k];
+            if (inGraph.fanOutStart[inNode + 1] - inGraph.fanOutStart[inNode] != 1)
+                continue;
+
+            for (int v = 0; v < 2; v++) {
+                if (inputValue != 2 && inputValue != v)
+                    continue;
+                JoinClasses(FaultNumber(inNode, v), FaultNumber(j, isInverting ? !v : v));
+            }
+        }
+    }
+
+    // The output fault with the non controlling value dominates the same fault on
+    // any of the inputs, so one input without other fan out is enough.
+    if (inDominance) {
+        for (int j = 0; j < inNodeList.size(); j++) {
+            int firstFanIn = inGraph.fanInStart[j];
+            int numberInputs = inGraph.fanInStart[j + 1] - firstFanIn;
+            if (numberInputs < 2)
+                continue;
+
+            int inputValue;
+            bool isInverting;
+            switch (inNodeList[j].gateType) {
+                case G_AND:  inputValue = 1; isInverting = false; break;
+                case G_NAND: inputValue = 1; isInverting = true;  break;
+                case G_OR:   inputValue = 0; isInverting = false; break;
+                case G_NOR:  inputValue = 0; isInverting = true;  break;
+                default:     continue;
+            }
+
+            int outClass = FindClass(FaultNumber(j, isInverting ? !inputValue : inputValue));
+            for (int k = firstFanIn; k < firstFanIn + numberInputs; k++) {
+                int inNode = inGraph.fanInList[k];
+                if (inGraph.fanOutStart[inNode + 1] - inGraph.fanOutStart[inNode] != 1)
+                    continue;
+                if (FindClass(FaultNumber(inNode, inputValue)) != outClass) {
+                    isDominating[outClass] = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    numberClasses = 0;
+    numberTargets = 0;
+    for (int i = 0; i < totalFaults; i++) {
+        if (FindClass(i) == i) {
+            numberClasses++;
+            if (!isDominating[i])
+                numberTargets++;
+        }
+    }
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  FaultClasses
+ *      Method:  FaultClasses :: FindClass
+ * Description:  Returns the number of the representative fault of the class of
+ *               the given fault. The path is halved on the way up.
+ *--------------------------------------------------------------------------------------
+ */
+int FaultClasses::FindClass (int inFault) {
+
+    while (classParent[inFault] != inFault) {
+        classParent[inFault] = classParent[classParent[inFault]];
+        inFault = classParent[inFault];
+    }
+    return inFault;
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  FaultClasses
+ *      Method:  FaultClasses :: JoinClasses
+ * Description:  Joins the classes of the two faults. The smaller representative is
+ *               kept, so the result does not depend on the order of the joins.
+ *--------------------------------------------------------------------------------------
+ */
+void FaultClasses::JoinClasses (int inFaultA, int inFaultB) {
+
+    int classA = FindClass(inFaultA);
+    int classB = FindClass(inFaultB);
+
+    if (classA < classB)
+        classParent[classB] = classA;
+    else if (classB < classA)
+        classParent[classA] = classB;
+}
+
+} /* namespace nameSpace_ATPG */
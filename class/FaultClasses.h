@@ -0,0 +1,114 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  FaultClasses.h
+ *
+ *    Description:  The FaultClasses class. This class groups the stuck at faults of the
+ *                  circuit into equivalence classes, so test generation only has to
+ *                  target one fault (the representative) of every class.
+ *
+ *        Version:  1.0
+ *        Created:  12/02/2011
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  Aditya Shevade <aditya.shevade@gmail.com>,
+ *                  Amey Marathe <marathe.amey@gmail.com>,
+ *                  Samik Biswas <samiksb@gmail.com>,
+ *                  Viraj Bhogle <viraj.bhogle@gmail.com>
+ *
+ * =====================================================================================
+ */
+
+#ifndef FAULTCLASSES_H_
+#define FAULTCLASSES_H_
+
+namespace nameSpace_ATPG {
+
+
+/*
+ * =====================================================================================
+ *        Class:  FaultClasses
+ *  Description:  Every fault has a number, 2 * node index + stuck at value. The classes
+ *                are kept in a union-find forest over these numbers. The representative
+ *                of a class is its fault with the smallest number.
+ *
+ *                The gate rules are used for equivalence -
+ *                      AND  - Input stuck at 0 is the output stuck at 0.
+ *                      NAND - Input stuck at 0 is the output stuck at 1.
+ *                      OR   - Input stuck at 1 is the output stuck at 1.
+ *                      NOR  - Input stuck at 1 is the output stuck at 0.
+ *                      NOT  - Input stuck at v is the output stuck at !v.
+ *                      Branch, and gates with one input, are buffers or inverters.
+ *                      XOR and XNOR with more inputs have no equivalent faults.
+ *
+ *                A rule is only applied to an input line that has no other fan out,
+ *                because a fault on a stem is not the same as a fault on one of its
+ *                branches.
+ *
+ *                With dominance, the class of the output fault that dominates an
+ *                input fault (AND output stuck at 1 over input stuck at 1, and so on)
+ *                is marked as dominating. Every test for the input fault also detects
+ *                it, so it is not a target for test generation.
+ * =====================================================================================
+ */
+class FaultClasses {
+    public:
+        int     numberClasses;      // Number of equivalence classes.
+        int     numberTargets;      // Classes that are not dominating.
+
+        /*
+         *--------------------------------------------------------------------------------------
+         *       Class:  FaultClasses
+         *      Method:  FaultClasses :: Build
+         * Description:  Builds the classes for all the faults in the circuit. The faults
+         *               that dominate others are also marked if inDominance is true.
+         *--------------------------------------------------------------------------------------
+         */
+        void Build (vector <CircuitNode> &inNodeList, CircuitGraph &inGraph, bool inDominance);
+
+        /*
+         *--------------------------------------------------------------------------------------
+         *       Class:  FaultClasses
+         *      Method:  FaultClasses :: FindClass
+         * Description:  Returns the number of the representative fault of the class of
+         *               the given fault.
+         *--------------------------------------------------------------------------------------
+         */
+        int FindClass (int inFault);
+
+        /*
+         *--------------------------------------------------------------------------------------
+         *       Class:  FaultClasses
+         *      Method:  FaultClasses :: IsTarget
+         * Description:  Returns true if the fault is the representative of its class and
+         *               the class is not dominating.
+         *--------------------------------------------------------------------------------------
+         */
+        bool IsTarget (int inFault) {
+            return (FindClass(inFault) == inFault && !isDominating[inFault]);
+        }
+
+        /*
+         *--------------------------------------------------------------------------------------
+         *       Class:  FaultClasses
+         *      Method:  FaultClasses :: FaultNumber
+         * Description:  Returns the number of the fault with the given node index and stuck
+         *               at value.
+         *--------------------------------------------------------------------------------------
+         */
+        static int FaultNumber (int inNode, bool inStuckAtValue) {
+            return 2 * inNode + (inStuckAtValue ? 1 : 0);
+        }
+
+    private:
+        friend class CircuitCache;
+
+        vector <int>    classParent;    // Union-find parent of each fault.
+        vector <bool>   isDominating;   // Set for the representative of a dominating class.
+
+        void    JoinClasses (int inFaultA, int inFaultB);
+};
+
+} /* namespace nameSpace_ATPG */
+#endif /* FAULTCLASSES_H_ */
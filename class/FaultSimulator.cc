@@ -0,0 +1,569 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  FaultSimulator.cc
+ *
+ *    Description:  This file defines the methods in the FaultSimulator class.
+ *                  The class grades test vectors against stuck at faults, a block of
+ *                  64, 256 or 512 vectors at a time.
+ *
+ *        Version:  1.0
+ *        Created:  12/02/2011
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  Aditya Shevade <aditya.shevade@gmail.com>,
+ *                  Amey Marathe <marathe.amey@gmail.com>,
+ *                  Samik Biswas <samiksb@gmail.com>,
+ *                  Viraj Bhogle <viraj.bhogle@gmail.com>
+ *
+ * =====================================================================================
+ */
+
+#include "FaultSimulator.h"
+
+// Global constants are defined in this file.
+
+#ifndef GLOBAL_DEFINES_H_
+#include "../include/global_defines.h"
+#endif
+
+namespace nameSpace_ATPG {
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  FaultSimulator
+ *      Method:  FaultSimulator :: FaultSimulator
+ * Description:  Takes in the node list of the circuit and its graph. The circuit
+ *               must already be levelized. The block size is the widest one the
+ *               processor can evaluate. The fanout-free regions are found here,
+ *               from the outputs back to the inputs.
+ *--------------------------------------------------------------------------------------
+ */
+FaultSimulator::FaultSimulator (vector <CircuitNode> &inNodeList, CircuitGraph &inGraph) : nodeList (inNodeList), graph (inGraph) {
+
+    int totalNodes = nodeList.size();
+    int maxInputs = 0;
+
+    isPathTracing = false;
+    evaluateWide = selectWideGate(blockWords);
+
+    goodOne.assign(totalNodes * blockWords, 0);
+    goodZero.assign(totalNodes * blockWords, 0);
+    faultOne.assign(totalNodes * blockWords, 0);
+    faultZero.assign(totalNodes * blockWords, 0);
+
+    validVectors.assign(blockWords, 0);
+    isExcited.assign(blockWords, 0);
+    isDetected.assign(blockWords, 0);
+    isChanged.assign(blockWords, 0);
+    newOne.assign(blockWords, 0);
+    newZero.assign(blockWords, 0);
+
+    levelQueue.resize(graph.maxLevel + 1);
+    levelEvents.assign((graph.maxLevel + 1) * blockWords, 0);
+    visitMark.assign(totalNodes, 0);
+    visitStamp = 0;
+
+    // A node with one fan out is in the region of that fan out, any other node is a root.
+    // The fan out is counted in the graph, numberFanOut of the branches is not their
+    // real fan out. A primary output is always a root.
+    regionRoot.assign(totalNodes, 0);
+    for (int i = graph.levelOrder.size() - 1; i >= 0; i--) {
+        int thisNode = graph.levelOrder[i];
+        if (graph.fanOutStart[thisNode + 1] - graph.fanOutStart[thisNode] == 1 && nodeList[thisNode].numberFanOut != 0)
+            regionRoot[thisNode] = regionRoot[graph.fanOutList[graph.fanOutStart[thisNode]]];
+        else
+            regionRoot[thisNode] = thisNode;
+        if (graph.fanInStart[thisNode + 1] - graph.fanInStart[thisNode] > maxInputs)
+            maxInputs = graph.fanInStart[thisNode + 1] - graph.fanInStart[thisNode];
+    }
+    isCritical.assign(totalNodes * blockWords, 0);
+    rootCritical.assign(totalNodes * blockWords, 0);
+    inputMask.assign(maxInputs + 1, 0);
+    rootMark.assign(totalNodes, 0);
+    rootStamp = 0;
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  FaultSimulator
+ *      Method:  FaultSimulator :: LoadVectors
+ * Description:  Packs inCount vectors, starting at inFirst, into the primary input
+ *               blocks. Vector number inFirst + k goes to bit k of the block, that is
+ *               bit k % 64 of word k / 64. Unused bits are X.
+ *--------------------------------------------------------------------------------------
+ */
+void FaultSimulator::LoadVectors (vector <string> &inVectorList, int inFirst, int inCount) {
+
+    for (int i = 0; i < graph.inputNodes.size(); i++) {
+        uint64_t *inputOne = &goodOne[graph.inputNodes[i] * blockWords];
+        uint64_t *inputZero = &goodZero[graph.inputNodes[i] * blockWords];
+        for (int w = 0; w < blockWords; w++) {
+            inputOne[w] = 0;
+            inputZero[w] = 0;
+        }
+        for (int k = 0; k < inCount; k++) {
+            string &thisVector = inVectorList[inFirst + k];
+            if (i >= thisVector.length())
+                continue;
+            if (thisVector[i] == '1')
+                inputOne[k >> 6] |= ((uint64_t) 1 << (k & 63));
+            else if (thisVector[i] == '0')
+                inputZero[k >> 6] |= ((uint64_t) 1 << (k & 63));
+        }
+    }
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  FaultSimulator
+ *      Method:  FaultSimulator :: SimulateGoodCircuit
+ * Description:  Simulates the fault free circuit for the loaded vectors. The faulty
+ *               values start as a copy of the fault free values.
+ *--------------------------------------------------------------------------------------
+ */
+void FaultSimulator::SimulateGoodCircuit () {
+
+    for (int i = 0; i < graph.levelOrder.size(); i++) {
+        int thisNode = graph.levelOrder[i];
+        int firstInput = graph.fanInStart[thisNode];
+        int numberInputs = graph.fanInStart[thisNode + 1] - firstInput;
+        if (numberInputs == 0)
+            continue;
+        evaluateWide (nodeList[thisNode].gateType, &goodOne[0], &goodZero[0], &graph.fanInList[firstInput],
+                      numberInputs, &goodOne[thisNode * blockWords], &goodZero[thisNode * blockWords]);
+    }
+
+    faultOne = goodOne;
+    faultZero = goodZero;
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  FaultSimulator
+ *      Method:  FaultSimulator :: ScheduleFanOut
+ * Description:  Adds the fan out of the node to the event queue, each node once.
+ *               inChange has a bit set for every vector where the faulty value of
+ *               the node differs from the fault free one. Returns the highest level
+ *               that was queued, or inMaxLevel if it is higher.
+ *--------------------------------------------------------------------------------------
+ */
+int FaultSimulator::ScheduleFanOut (int inNode, const uint64_t *inChange, int inMaxLevel) {
+
+    for (int j = graph.fanOutStart[inNode]; j < graph.fanOutStart[inNode + 1]; j++) {
+        int nextNode = graph.fanOutList[j];
+        int nextLevel = nodeList[nextNode].lineLevel;
+        for (int w = 0; w < blockWords; w++)
+            levelEvents[nextLevel * blockWords + w] |= inChange[w];
+        if (visitMark[nextNode] != visitStamp) {
+            visitMark[nextNode] = visitStamp;
+            levelQueue[nextLevel].push_back(nextNode);
+            if (nextLevel > inMaxLevel)
+                inMaxLevel = nextLevel;
+        }
+    }
+    return inMaxLevel;
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  FaultSimulator
+ *      Method:  FaultSimulator :: SimulateFault
+ * Description:  Injects the fault at the given node and simulates its effect. Sets a
+ *               bit in isDetected for every loaded vector that detects the fault and
+ *               returns true if there is any. The faulty values are restored
+ *               afterwards.
+ *
+ *               The simulation is event driven. A node is only evaluated when one of
+ *               its inputs has a faulty value different from the fault free one, and
+ *               the nodes are taken level by level so every node is evaluated once.
+ *               The fault effect usually dies out well before the end of the cone.
+ *
+ *               levelEvents keeps, for every level, the vectors that have an event
+ *               waiting there. Together they are the D-frontier of every vector.
+ *               Once every vector that is still alive has been detected, nothing
+ *               the rest of the queue can do changes the result, so the simulation
+ *               stops early.
+ *--------------------------------------------------------------------------------------
+ */
+bool FaultSimulator::SimulateFault (int inNode, bool inStuckAtValue) {
+
+    uint64_t *siteOne = &faultOne[inNode * blockWords];
+    uint64_t *siteZero = &faultZero[inNode * blockWords];
+    uint64_t anyExcited = 0;
+
+    // The fault is excited only by the vectors where the line has the opposite value.
+    counters.faultSimulations++;
+    for (int w = 0; w < blockWords; w++) {
+        isExcited[w] = (inStuckAtValue ? goodZero[inNode * blockWords + w] : goodOne[inNode * blockWords + w]) & validVectors[w];
+        isDetected[w] = 0;
+        counters.vectorsNotExcited += __builtin_popcountll(validVectors[w] & ~isExcited[w]);
+        anyExcited |= isExcited[w];
+    }
+    if (anyExcited == 0)
+        return false;
+
+    // Only the loaded vectors get the stuck at value, so that the unused bits do
+    // not cause events.
+    for (int w = 0; w < blockWords; w++) {
+        siteOne[w] = (inStuckAtValue ? validVectors[w] : 0);
+        siteZero[w] = (inStuckAtValue ? 0 : validVectors[w]);
+    }
+    changedNodes.clear();
+    changedNodes.push_back(inNode);
+
+    bool isNewDetection = false;
+    if (nodeList[inNode].numberFanOut == 0) {
+        for (int w = 0; w < blockWords; w++) {
+            isDetected[w] = (goodOne[inNode * blockWords + w] & siteZero[w]) | (goodZero[inNode * blockWords + w] & siteOne[w]);
+            isNewDetection |= (isDetected[w] != 0);
+        }
+    }
+
+    visitStamp++;
+    int lastLevel = ScheduleFanOut(inNode, &isExcited[0], nodeList[inNode].lineLevel);
+    for (int level = nodeList[inNode].lineLevel + 1; level <= lastLevel; level++) {
+        if (isNewDetection) {
+            isNewDetection = false;
+            uint64_t isOpen = 0;
+            for (int w = 0; w < blockWords; w++) {
+                uint64_t isAlive = 0;
+                for (int l = level; l <= lastLevel; l++)
+                    isAlive |= levelEvents[l * blockWords + w];
+                isOpen |= isAlive & isExcited[w] & ~isDetected[w];
+            }
+            if (isOpen == 0) {
+                for (int l = level; l <= lastLevel; l++) {
+                    levelQueue[l].clear();
+                    for (int w = 0; w < blockWords; w++)
+                        levelEvents[l * blockWords + w] = 0;
+                }
+                counters.earlyStops++;
+                break;
+            }
+        }
+
+        // Events only go to higher levels, so this bucket does not grow here.
+        for (int i = 0; i < levelQueue[level].size(); i++) {
+            int thisNode = levelQueue[level][i];
+            int firstInput = graph.fanInStart[thisNode];
+            int numberInputs = graph.fanInStart[thisNode + 1] - firstInput;
+            uint64_t *thisGoodOne = &goodOne[thisNode * blockWords];
+            uint64_t *thisGoodZero = &goodZero[thisNode * blockWords];
+
+            evaluateWide (nodeList[thisNode].gateType, &faultOne[0], &faultZero[0], &graph.fanInList[firstInput],
+                          numberInputs, &newOne[0], &newZero[0]);
+            counters.gateEvaluations++;
+            uint64_t anyChanged = 0;
+            for (int w = 0; w < blockWords; w++) {
+                isChanged[w] = (newOne[w] ^ thisGoodOne[w]) | (newZero[w] ^ thisGoodZero[w]);
+                anyChanged |= isChanged[w];
+            }
+            if (anyChanged == 0)
+                continue;
+
+            for (int w = 0; w < blockWords; w++) {
+                faultOne[thisNode * blockWords + w] = newOne[w];
+                faultZero[thisNode * blockWords + w] = newZero[w];
+            }
+            changedNodes.push_back(thisNode);
+            if (nodeList[thisNode].numberFanOut == 0) {
+                for (int w = 0; w < blockWords; w++) {
+                    uint64_t isOutputDetected = (thisGoodOne[w] & newZero[w]) | (thisGoodZero[w] & newOne[w]);
+                    isNewDetection |= ((isOutputDetected & ~isDetected[w]) != 0);
+                    isDetected[w] |= isOutputDetected;
+                }
+            }
+            lastLevel = ScheduleFanOut(thisNode, &isChanged[0], lastLevel);
+        }
+        levelQueue[level].clear();
+        for (int w = 0; w < blockWords; w++)
+            levelEvents[level * blockWords + w] = 0;
+    }
+
+    for (int i = 0; i < changedNodes.size(); i++) {
+        int thisNode = changedNodes[i];
+        for (int w = 0; w < blockWords; w++) {
+            faultOne[thisNode * blockWords + w] = goodOne[thisNode * blockWords + w];
+            faultZero[thisNode * blockWords + w] = goodZero[thisNode * blockWords + w];
+        }
+    }
+
+    uint64_t anyDetected = 0;
+    for (int w = 0; w < blockWords; w++) {
+        counters.vectorsDetected += __builtin_popcountll(isDetected[w]);
+        counters.vectorsBlocked += __builtin_popcountll(isExcited[w] & ~isDetected[w]);
+        anyDetected |= isDetected[w];
+    }
+    return (anyDetected != 0);
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  FaultSimulator
+ *      Method:  FaultSimulator :: TraceGate
+ * Description:  Sets isCritical for the inputs of the node that have no other fan
+ *               out, from isCritical of the node. An input is sensitive when it is
+ *               known and every other input lets it through, that is 1 for AND and
+ *               NAND, 0 for OR and NOR, and known for XOR and XNOR.
+ *
+ *               inputMask[j] holds the AND of the masks of inputs 0 to j - 1, and
+ *               the masks of the inputs after j are collected on the way back.
+ *--------------------------------------------------------------------------------------
+ */
+void FaultSimulator::TraceGate (int inNode) {
+
+    int firstInput = graph.fanInStart[inNode];
+    int numberInputs = graph.fanInStart[inNode + 1] - firstInput;
+    unsigned int gateType = nodeList[inNode].gateType;
+
+    for (int w = 0; w < blockWords; w++) {
+        uint64_t nodeCritical = isCritical[inNode * blockWords + w];
+
+        inputMask[0] = ~((uint64_t) 0);
+        for (int j = 0; j < numberInputs && nodeCritical != 0; j++) {
+            int inputNode = graph.fanInList[firstInput + j];
+            uint64_t thisOne = goodOne[inputNode * blockWords + w];
+            uint64_t thisZero = goodZero[inputNode * blockWords + w];
+            if (gateType == G_AND || gateType == G_NAND)
+                inputMask[j + 1] = inputMask[j] & thisOne;
+            else if (gateType == G_OR || gateType == G_NOR)
+                inputMask[j + 1] = inputMask[j] & thisZero;
+            else
+                inputMask[j + 1] = inputMask[j] & (thisOne | thisZero);
+        }
+
+        uint64_t laterMask = ~((uint64_t) 0);
+        for (int j = numberInputs - 1; j >= 0; j--) {
+            int inputNode = graph.fanInList[firstInput + j];
+            uint64_t thisOne = goodOne[inputNode * blockWords + w];
+            uint64_t thisZero = goodZero[inputNode * blockWords + w];
+            if (regionRoot[inputNode] != inputNode) {
+                if (nodeCritical == 0)
+                    isCritical[inputNode * blockWords + w] = 0;
+                else
+                    isCritical[inputNode * blockWords + w] = nodeCritical & (thisOne | thisZero) & inputMask[j] & laterMask;
+            }
+            if (gateType == G_AND || gateType == G_NAND)
+                laterMask &= thisOne;
+            else if (gateType == G_OR || gateType == G_NOR)
+                laterMask &= thisZero;
+            else
+                laterMask &= (thisOne | thisZero);
+        }
+    }
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  FaultSimulator
+ *      Method:  FaultSimulator :: TraceFaults
+ * Description:  Same as the fault loop of SimulateVectors, with critical path tracing
+ *               for the loaded block. Only the regions with faults in
+ *               ioRemainingFaults are traced.
+ *
+ *               The backward pass first takes every root as critical wherever it is
+ *               known, which gives the vectors where a line flips its root. The
+ *               vectors where some fault of the region flips the root are its
+ *               demand. A primary output is really critical wherever it is known. A
+ *               stem is simulated stuck at 0 and stuck at 1 for the vectors of its
+ *               demand only, and it is critical where either is detected. A fault is
+ *               detected where it flips its root and the root is critical.
+ *--------------------------------------------------------------------------------------
+ */
+void FaultSimulator::TraceFaults (int inFirst, vector <FaultList> &inFaultList, vector <int> &ioRemainingFaults,
+                                  vector <int> &outDetectedFaults, vector <int> &outDetectingVector) {
+
+    vector <int> faultNode (ioRemainingFaults.size());
+
+    rootStamp++;
+    for (int i = 0; i < ioRemainingFaults.size(); i++) {
+        faultNode[i] = graph.FindNode(inFaultList[ioRemainingFaults[i]].lineNumber);
+        if (faultNode[i] >= 0)
+            rootMark[regionRoot[faultNode[i]]] = rootStamp;
+    }
+
+    regionRoots.clear();
+    for (int i = graph.levelOrder.size() - 1; i >= 0; i--) {
+        int thisNode = graph.levelOrder[i];
+        if (rootMark[regionRoot[thisNode]] != rootStamp)
+            continue;
+
+        if (regionRoot[thisNode] == thisNode) {
+            regionRoots.push_back(thisNode);
+            for (int w = 0; w < blockWords; w++) {
+                isCritical[thisNode * blockWords + w] = (goodOne[thisNode * blockWords + w] | goodZero[thisNode * blockWords + w]) & validVectors[w];
+                rootCritical[thisNode * blockWords + w] = 0;
+            }
+        }
+        if (graph.fanInStart[thisNode + 1] > graph.fanInStart[thisNode])
+            TraceGate(thisNode);
+    }
+
+    for (int i = 0; i < ioRemainingFaults.size(); i++) {
+        int thisNode = faultNode[i];
+        if (thisNode < 0)
+            continue;
+        const uint64_t *isFaultExcited = (inFaultList[ioRemainingFaults[i]].stuckAtValue ? &goodZero[thisNode * blockWords] :
+                                                                                           &goodOne[thisNode * blockWords]);
+        for (int w = 0; w < blockWords; w++)
+            rootCritical[regionRoot[thisNode] * blockWords + w] |= isCritical[thisNode * blockWords + w] & isFaultExcited[w];
+    }
+
+    // The stems are simulated with the demand as the loaded vectors.
+    vector <uint64_t> loadedVectors (validVectors);
+    for (int i = 0; i < regionRoots.size(); i++) {
+        int thisNode = regionRoots[i];
+        uint64_t *thisDemand = &rootCritical[thisNode * blockWords];
+        uint64_t needZero = 0, needOne = 0;
+        if (nodeList[thisNode].numberFanOut == 0)
+            continue;
+        for (int w = 0; w < blockWords; w++) {
+            validVectors[w] = thisDemand[w];
+            needZero |= thisDemand[w] & goodOne[thisNode * blockWords + w];
+            needOne |= thisDemand[w] & goodZero[thisNode * blockWords + w];
+            thisDemand[w] = 0;
+        }
+        if (needZero != 0 && SimulateFault(thisNode, false)) {
+            for (int w = 0; w < blockWords; w++)
+                thisDemand[w] |= isDetected[w];
+        }
+        if (needOne != 0 && SimulateFault(thisNode, true)) {
+            for (int w = 0; w < blockWords; w++)
+                thisDemand[w] |= isDetected[w];
+        }
+    }
+    validVectors = loadedVectors;
+
+    outDetectedFaults.clear();
+    outDetectingVector.clear();
+    int numberRemaining = 0;
+    for (int i = 0; i < ioRemainingFaults.size(); i++) {
+        int thisFault = ioRemainingFaults[i];
+        int thisNode = faultNode[i];
+        int detectingWord = -1;
+        uint64_t isFaultDetected = 0;
+        for (int w = 0; thisNode >= 0 && w < blockWords; w++) {
+            uint64_t isFaultExcited = (inFaultList[thisFault].stuckAtValue ? goodZero[thisNode * blockWords + w] :
+                                                                            goodOne[thisNode * blockWords + w]);
+            isFaultDetected = isCritical[thisNode * blockWords + w] & isFaultExcited & rootCritical[regionRoot[thisNode] * blockWords + w];
+            if (isFaultDetected != 0) {
+                detectingWord = w;
+                break;
+            }
+        }
+        if (detectingWord >= 0) {
+            outDetectedFaults.push_back(thisFault);
+            outDetectingVector.push_back(inFirst + 64 * detectingWord + __builtin_ctzll(isFaultDetected));
+        }
+        else
+            ioRemainingFaults[numberRemaining++] = thisFault;
+    }
+    ioRemainingFaults.resize(numberRemaining);
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  FaultSimulator
+ *      Method:  FaultSimulator :: GradeVectors
+ * Description:  Simulates all the vectors against all the faults. For every fault,
+ *               outDetectingVector has the index of the first vector in the list
+ *               that detects it, or -1 if no vector detects it. A fault is not
+ *               simulated any more once it is detected.
+ *--------------------------------------------------------------------------------------
+ */
+void FaultSimulator::GradeVectors (vector <string> &inVectorList, vector <FaultList> &inFaultList, vector <int> &outDetectingVector) {
+
+    vector <int> remainingFaults;
+    vector <int> detectedFaults;
+    vector <int> detectingVector;
+
+    outDetectingVector.assign(inFaultList.size(), -1);
+    for (int i = 0; i < inFaultList.size(); i++) {
+        remainingFaults.push_back(i);
+    }
+
+    for (int first = 0; first < inVectorList.size() && !remainingFaults.empty(); first += BlockSize()) {
+        int count = inVectorList.size() - first;
+        if (count > BlockSize())
+            count = BlockSize();
+
+        SimulateVectors(inVectorList, first, count, inFaultList, remainingFaults, detectedFaults, detectingVector);
+        for (int i = 0; i < detectedFaults.size(); i++) {
+            outDetectingVector[detectedFaults[i]] = detectingVector[i];
+        }
+    }
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  FaultSimulator
+ *      Method:  FaultSimulator :: SimulateVectors
+ * Description:  Simulates up to BlockSize() vectors, inCount vectors of inVectorList
+ *               starting at inFirst, against the faults whose indices in inFaultList
+ *               are given in ioRemainingFaults. The faults detected by any of the
+ *               vectors are moved from ioRemainingFaults to outDetectedFaults, and for
+ *               each of them outDetectingVector has the index in inVectorList of the
+ *               first vector that detects it.
+ *--------------------------------------------------------------------------------------
+ */
+void FaultSimulator::SimulateVectors (vector <string> &inVectorList, int inFirst, int inCount, vector <FaultList> &inFaultList,
+                                      vector <int> &ioRemainingFaults, vector <int> &outDetectedFaults, vector <int> &outDetectingVector) {
+
+    for (int w = 0; w < blockWords; w++) {
+        int wordCount = inCount - 64 * w;
+        if (wordCount >= 64)
+            validVectors[w] = ~((uint64_t) 0);
+        else if (wordCount > 0)
+            validVectors[w] = ((uint64_t) 1 << wordCount) - 1;
+        else
+            validVectors[w] = 0;
+    }
+
+    LoadVectors(inVectorList, inFirst, inCount);
+    SimulateGoodCircuit();
+
+    if (isPathTracing) {
+        TraceFaults(inFirst, inFaultList, ioRemainingFaults, outDetectedFaults, outDetectingVector);
+        return;
+    }
+
+    // Detected faults are dropped, the rest are kept for the next vectors.
+    outDetectedFaults.clear();
+    outDetectingVector.clear();
+    int numberRemaining = 0;
+    for (int i = 0; i < ioRemainingFaults.size(); i++) {
+        int thisFault = ioRemainingFaults[i];
+        int thisNode = graph.FindNode(inFaultList[thisFault].lineNumber);
+        if (thisNode >= 0 && SimulateFault(thisNode, inFaultList[thisFault].stuckAtValue)) {
+            int w = 0;
+            while (isDetected[w] == 0)
+                w++;
+            outDetectedFaults.push_back(thisFault);
+            outDetectingVector.push_back(inFirst + 64 * w + __builtin_ctzll(isDetected[w]));
+        }
+        else
+            ioRemainingFaults[numberRemaining++] = thisFault;
+    }
+    ioRemainingFaults.resize(numberRemaining);
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  FaultSimulator
+ *      Method:  FaultSimulator :: SimulateVector
+ * Description:  Simulates one vector against the faults whose indices in
+ *               inFaultList are given in ioRemainingFaults. The faults detected by
+ *               the vector are moved from ioRemainingFaults to outDetectedFaults.
+ *--------------------------------------------------------------------------------------
+ */
+void FaultSimulator::SimulateVector (string &inVector, vector <FaultList> &inFaultList, vector <int> &ioRemainingFaults, vector <int> &outDetectedFaults) {
+
+    vector <string> thisBlock (1, inVector);
+    vector <int> detectingVector;
+
+    SimulateVectors(thisBlock, 0, 1, inFaultList, ioRemainingFaults, outDetectedFaults, detectingVector);
+}
+
+} /* namespace nameSpace_ATPG */
@@ -0,0 +1,214 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  FaultSimulator.h
+ *
+ *    Description:  The FaultSimulator class. This class grades a list of test vectors
+ *                  against a list of stuck at faults.
+ *
+ *                  It is a parallel pattern single fault propagation (PPSFP) simulator.
+ *                  A block of vectors is packed in machine words, the fault free
+ *                  circuit is simulated once per block and then every fault is
+ *                  simulated event driven, only through the gates its effect reaches.
+ *
+ *                  A block is 64 vectors (one 64 bit word), or 256 or 512 vectors when
+ *                  the processor has AVX2 or AVX-512. The results are the same for
+ *                  every block size.
+ *
+ *                  With critical path tracing the faults inside a fanout-free region
+ *                  are not simulated one by one. Only the stems are simulated, and the
+ *                  rest of the region is handled by one backward pass.
+ *
+ *        Version:  1.0
+ *        Created:  12/02/2011
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  Aditya Shevade <aditya.shevade@gmail.com>,
+ *                  Amey Marathe <marathe.amey@gmail.com>,
+ *                  Samik Biswas <samiksb@gmail.com>,
+ *                  Viraj Bhogle <viraj.bhogle@gmail.com>
+ *
+ * =====================================================================================
+ */
+
+#ifndef FAULTSIMULATOR_H_
+#define FAULTSIMULATOR_H_
+
+namespace nameSpace_ATPG {
+
+
+/*
+ * =====================================================================================
+ *        Class:  SimulationCounters
+ *  Description:  Counts of the work done by a FaultSimulator. A vector is counted once
+ *                for every fault it is simulated against, as not exciting the fault,
+ *                detecting it, or blocked (the fault effect died before an output).
+ * =====================================================================================
+ */
+class SimulationCounters {
+    public:
+        unsigned    long    faultSimulations;   // Faults simulated against a block of vectors.
+        unsigned    long    vectorsNotExcited;  // Rejected at the fault site.
+        unsigned    long    vectorsBlocked;     // Rejected when the D-frontier was empty.
+        unsigned    long    vectorsDetected;
+        unsigned    long    earlyStops;         // Simulations stopped before the queue was empty.
+        unsigned    long    gateEvaluations;    // Gates evaluated in the faulty circuit.
+
+        SimulationCounters () {
+            faultSimulations = vectorsNotExcited = vectorsBlocked = vectorsDetected = earlyStops = gateEvaluations = 0;
+        }
+
+        void Add (SimulationCounters &inCounters) {
+            faultSimulations += inCounters.faultSimulations;
+            vectorsNotExcited += inCounters.vectorsNotExcited;
+            vectorsBlocked += inCounters.vectorsBlocked;
+            vectorsDetected += inCounters.vectorsDetected;
+            earlyStops += inCounters.earlyStops;
+            gateEvaluations += inCounters.gateEvaluations;
+        }
+
+        void Write (ostream &outStream) {
+            outStream << "Fault simulations = " << faultSimulations << endl;
+            outStream << "Vectors not exciting the fault = " << vectorsNotExcited << endl;
+            outStream << "Vectors with the fault effect blocked = " << vectorsBlocked << endl;
+            outStream << "Vectors detecting the fault = " << vectorsDetected << endl;
+            outStream << "Simulations stopped early = " << earlyStops << endl;
+            outStream << "Gate evaluations = " << gateEvaluations << endl;
+        }
+};
+
+
+/*
+ * =====================================================================================
+ *        Class:  FaultSimulator
+ *  Description:  Every line value is kept as two blocks of words, one bit per vector.
+ *                A bit set in the ONE block means the line is 1 for that vector, a
+ *                bit set in the ZERO block means the line is 0. If neither is set,
+ *                the line is X. The block of node i starts at word i * blockWords.
+ *
+ *                A fault is detected by a vector when some primary output has a
+ *                known value in both the fault free and the faulty circuit and the
+ *                two values are different.
+ *
+ *                A line is critical for a vector when flipping its (known) value
+ *                makes the vector detect it. A fanout-free region is a stem or a
+ *                primary output, its root, together with all the lines that only
+ *                reach the rest of the circuit through it. The fan out of a stem
+ *                are the branches (BRNCH nodes) of the circuit file, and each of
+ *                them is in the region of the gate it feeds. A line in a region is
+ *                critical when the gate it feeds is critical and the line is
+ *                sensitive, that is flipping it flips the known gate output. A
+ *                fault is detected where its line is critical and the line has the
+ *                opposite of the stuck at value. The results are the same as
+ *                simulating every fault.
+ * =====================================================================================
+ */
+class FaultSimulator {
+    public:
+        SimulationCounters  counters;           // Work done, all calls.
+        bool                isPathTracing;      // Use critical path tracing, false by default.
+
+        /*
+         *--------------------------------------------------------------------------------------
+         *       Class:  FaultSimulator
+         *      Method:  FaultSimulator :: FaultSimulator
+         * Description:  Takes in the node list of the circuit and its graph. The circuit
+         *               must already be levelized.
+         *--------------------------------------------------------------------------------------
+         */
+        FaultSimulator (vector <CircuitNode> &inNodeList, CircuitGraph &inGraph);
+
+        /*
+         *--------------------------------------------------------------------------------------
+         *       Class:  FaultSimulator
+         *      Method:  FaultSimulator :: BlockSize
+         * Description:  Returns the number of vectors simulated at a time.
+         *--------------------------------------------------------------------------------------
+         */
+        int BlockSize () {
+            return 64 * blockWords;
+        }
+
+        /*
+         *--------------------------------------------------------------------------------------
+         *       Class:  FaultSimulator
+         *      Method:  FaultSimulator :: GradeVectors
+         * Description:  Simulates all the vectors against all the faults. For every fault,
+         *               outDetectingVector has the index of the first vector in the list
+         *               that detects it, or -1 if no vector detects it. A fault is not
+         *               simulated any more once it is detected.
+         *--------------------------------------------------------------------------------------
+         */
+        void GradeVectors (vector <string> &inVectorList, vector <FaultList> &inFaultList, vector <int> &outDetectingVector);
+
+        /*
+         *--------------------------------------------------------------------------------------
+         *       Class:  FaultSimulator
+         *      Method:  FaultSimulator :: SimulateVectors
+         * Description:  Simulates up to BlockSize() vectors, inCount vectors of inVectorList
+         *               starting at inFirst, against the faults whose indices in inFaultList
+         *               are given in ioRemainingFaults. The faults detected by any of the
+         *               vectors are moved from ioRemainingFaults to outDetectedFaults, and for
+         *               each of them outDetectingVector has the index in inVectorList of the
+         *               first vector that detects it.
+         *--------------------------------------------------------------------------------------
+         */
+        void SimulateVectors (vector <string> &inVectorList, int inFirst, int inCount, vector <FaultList> &inFaultList,
+                              vector <int> &ioRemainingFaults, vector <int> &outDetectedFaults, vector <int> &outDetectingVector);
+
+        /*
+         *--------------------------------------------------------------------------------------
+         *       Class:  FaultSimulator
+         *      Method:  FaultSimulator :: SimulateVector
+         * Description:  Simulates one vector against the faults whose indices in
+         *               inFaultList are given in ioRemainingFaults. The faults detected by
+         *               the vector are moved from ioRemainingFaults to outDetectedFaults.
+         *--------------------------------------------------------------------------------------
+         */
+        void SimulateVector (string &inVector, vector <FaultList> &inFaultList, vector <int> &ioRemainingFaults, vector <int> &outDetectedFaults);
+
+    private:
+        vector <CircuitNode>        &nodeList;      // The circuit, read only.
+        CircuitGraph                &graph;         // Fan in and fan out of the nodes, read only.
+
+        int                         blockWords;     // Words per line value, 1, 4 or 8.
+        WideGateFunction            evaluateWide;   // Gate evaluation for blockWords words.
+
+        vector <uint64_t>           goodOne;        // Fault free values, 1 bits.
+        vector <uint64_t>           goodZero;       // Fault free values, 0 bits.
+        vector <uint64_t>           faultOne;       // Faulty values, 1 bits.
+        vector <uint64_t>           faultZero;      // Faulty values, 0 bits.
+
+        vector <uint64_t>           validVectors;   // One bit for every loaded vector.
+        vector <uint64_t>           isExcited;      // Vectors that excite the current fault.
+        vector <uint64_t>           isDetected;     // Vectors that detect the current fault.
+        vector <uint64_t>           isChanged;      // Vectors where a node has a fault effect.
+        vector <uint64_t>           newOne;         // Faulty value of the node being evaluated.
+        vector <uint64_t>           newZero;
+
+        vector < vector <int> >     levelQueue;     // Nodes waiting for evaluation, by level.
+        vector <uint64_t>           levelEvents;    // Vectors with an event waiting, by level.
+        vector <int>                changedNodes;   // Nodes with a faulty value, to restore.
+        vector <unsigned int>       visitMark;      // Marks for the nodes already queued.
+        unsigned    int             visitStamp;
+
+        vector <int>                regionRoot;     // Root of the fanout-free region of each node.
+        vector <uint64_t>           isCritical;     // Vectors where each node flips its region root.
+        vector <uint64_t>           rootCritical;   // Vectors where each root is critical.
+        vector <int>                regionRoots;    // Roots of the regions being traced.
+        vector <uint64_t>           inputMask;      // Inputs that do not block the gate, one word each.
+        vector <unsigned int>       rootMark;       // Regions that have faults left to grade.
+        unsigned    int             rootStamp;
+
+        void        LoadVectors (vector <string> &inVectorList, int inFirst, int inCount);
+        void        SimulateGoodCircuit ();
+        int         ScheduleFanOut (int inNode, const uint64_t *inChange, int inMaxLevel);
+        bool        SimulateFault (int inNode, bool inStuckAtValue);
+        void        TraceGate (int inNode);
+        void        TraceFaults (int inFirst, vector <FaultList> &inFaultList, vector <int> &ioRemainingFaults,
+                                 vector <int> &outDetectedFaults, vector <int> &outDetectingVector);
+};
+
+} /* namespace nameSpace_ATPG */
+#endif /* FAULTSIMULATOR_H_ */
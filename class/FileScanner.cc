@@ -0,0 +1,183 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  FileScanner.cc
+ *
+ *    Description:  This file defines the methods in the FileScanner class.
+ *                  The class reads the numbers in the circuit and fault list files.
+ *
+ *        Version:  1.0
+ *        Created:  12/02/2011
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  Aditya Shevade <aditya.shevade@gmail.com>,
+ *                  Amey Marathe <marathe.amey@gmail.com>,
+ *                  Samik Biswas <samiksb@gmail.com>,
+ *                  Viraj Bhogle <viraj.bhogle@gmail.com>
+ *
+ * =====================================================================================
+ */
+
+#include "FileScanner.h"
+
+// Global constants are defined in this file.
+
+#ifndef GLOBAL_DEFINES_H_
+#include "../include/global_defines.h"
+#endif
+
+namespace nameSpace_ATPG {
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  FileScanner
+ *      Method:  FileScanner :: FileScanner
+ * Description:  Maps the file into memory. The program exits if the file can not be
+ *               opened.
+ *--------------------------------------------------------------------------------------
+ */
+FileScanner::FileScanner (char *inFileName) {
+
+    fileName = inFileName;
+    fileData = mapFile(inFileName, fileSize);
+    if (fileData == NULL) {
+        cerr << "ERROR: File could not be opened." << endl;
+        exit (1);
+    }
+
+    position = lineStart = tokenStart = fileData;
+    fileEnd = fileData + fileSize;
+    lineNumber = 1;
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  FileScanner
+ *      Method:  FileScanner :: ~FileScanner
+ * Description:  Releases the mapped file.
+ *--------------------------------------------------------------------------------------
+ */
+FileScanner::~FileScanner () {
+    unmapFile(fileData, fileSize);
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  FileScanner
+ *      Method:  FileScanner :: NumberLines
+ * Description:  Returns the number of lines in the file, counting a last line that
+ *               has no line feed.
+ *--------------------------------------------------------------------------------------
+ */
+size_t FileScanner::NumberLines () {
+
+    size_t numberLines = 0;
+    const char *thisChar = fileData;
+    while ((thisChar = (const char *)memchr(thisChar, '\n', fileEnd - thisChar)) != NULL) {
+        numberLines++;
+        thisChar++;
+    }
+    if (fileSize > 0 && fileEnd[-1] != '\n')
+        numberLines++;
+    return numberLines;
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  FileScanner
+ *      Method:  FileScanner :: SkipSpaces
+ * Description:  Skips the spaces, tabs and carriage returns up to the next number or
+ *               the end of the line.
+ *--------------------------------------------------------------------------------------
+ */
+void FileScanner::SkipSpaces () {
+    while (position < fileEnd && (*position == ' ' || *position == '\t' || *position == '\r')) {
+        position++;
+    }
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  FileScanner
+ *      Method:  FileScanner :: NextRecord
+ * Description:  Moves to the first number of the next line that is not blank.
+ *               Returns false at the end of the file.
+ *--------------------------------------------------------------------------------------
+ */
+bool FileScanner::NextRecord () {
+
+    while (true) {
+        SkipSpaces();
+        if (position == fileEnd)
+            return false;
+        if (*position != '\n')
+            return true;
+        position++;
+        lineStart = position;
+        lineNumber++;
+    }
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  FileScanner
+ *      Method:  FileScanner :: ReadNumber
+ * Description:  Returns the next number on the line. The number must be made of
+ *               decimal digits only and fit in an unsigned int.
+ *--------------------------------------------------------------------------------------
+ */
+unsigned int FileScanner::ReadNumber () {
+
+    SkipSpaces();
+    tokenStart = position;
+    if (position == fileEnd || *position == '\n')
+        Error("The line ends before all its numbers.");
+
+    uint64_t thisNumber = 0;
+    while (position < fileEnd && (unsigned char)(*position - '0') <= 9) {
+        thisNumber = 10 * thisNumber + (*position - '0');
+        if (thisNumber > UINT_MAX)
+            Error("The number is too large.");
+        position++;
+    }
+
+    // The number has to end with a space or the end of the line.
+    if (position == tokenStart ||
+        (position < fileEnd && *position != ' ' && *position != '\t' && *position != '\r' && *position != '\n'))
+        Error("Expected a number.");
+
+    return thisNumber;
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  FileScanner
+ *      Method:  FileScanner :: EndRecord
+ * Description:  Checks that nothing but spaces is left on the line.
+ *--------------------------------------------------------------------------------------
+ */
+void FileScanner::EndRecord () {
+
+    SkipSpaces();
+    if (position < fileEnd && *position != '\n') {
+        tokenStart = position;
+        Error("Unexpected text at the end of the line.");
+    }
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  FileScanner
+ *      Method:  FileScanner :: Error
+ * Description:  Reports the message at the line and column of the last number read,
+ *               or of the text that could not be read, and exits.
+ *--------------------------------------------------------------------------------------
+ */
+void FileScanner::Error (const char *inMessage) {
+    cerr << "ERROR: " << fileName << ", line " << lineNumber << ", column " << (tokenStart - lineStart + 1) << ":" << endl
+         << inMessage << endl;
+    exit (1);
+}
+
+} /* namespace nameSpace_ATPG */
@@ -0,0 +1,126 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  FileScanner.h
+ *
+ *    Description:  The FileScanner class. This class reads the numbers in the circuit
+ *                  and fault list files, one line at a time, straight from the file
+ *                  mapped into memory.
+ *
+ *        Version:  1.0
+ *        Created:  12/02/2011
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  Aditya Shevade <aditya.shevade@gmail.com>,
+ *                  Amey Marathe <marathe.amey@gmail.com>,
+ *                  Samik Biswas <samiksb@gmail.com>,
+ *                  Viraj Bhogle <viraj.bhogle@gmail.com>
+ *
+ * =====================================================================================
+ */
+
+#ifndef FILESCANNER_H_
+#define FILESCANNER_H_
+
+namespace nameSpace_ATPG {
+
+
+/*
+ * =====================================================================================
+ *        Class:  FileScanner
+ *  Description:  Every line of the file is one record of numbers separated by spaces
+ *                or tabs. Blank lines are skipped. A record is read with NextRecord,
+ *                then ReadNumber for each of its numbers and EndRecord once it is
+ *                complete.
+ *
+ *                Anything that does not fit, a line that ends too early, text that
+ *                is not a number or is left over at the end of a line, is reported
+ *                with Error, with the line and column where it was found, and the
+ *                program exits.
+ * =====================================================================================
+ */
+class FileScanner {
+    public:
+        /*
+         *--------------------------------------------------------------------------------------
+         *       Class:  FileScanner
+         *      Method:  FileScanner :: FileScanner
+         * Description:  Maps the file into memory. The program exits if the file can
+         *               not be opened.
+         *--------------------------------------------------------------------------------------
+         */
+        FileScanner (char *inFileName);
+
+        /*
+         *--------------------------------------------------------------------------------------
+         *       Class:  FileScanner
+         *      Method:  FileScanner :: ~FileScanner
+         * Description:  Releases the mapped file.
+         *--------------------------------------------------------------------------------------
+         */
+        ~FileScanner ();
+
+        /*
+         *--------------------------------------------------------------------------------------
+         *       Class:  FileScanner
+         *      Method:  FileScanner :: NumberLines
+         * Description:  Returns the number of lines in the file, an upper bound on the
+         *               number of records.
+         *--------------------------------------------------------------------------------------
+         */
+        size_t NumberLines ();
+
+        /*
+         *--------------------------------------------------------------------------------------
+         *       Class:  FileScanner
+         *      Method:  FileScanner :: NextRecord
+         * Description:  Moves to the first number of the next line that is not blank.
+         *               Returns false at the end of the file.
+         *--------------------------------------------------------------------------------------
+         */
+        bool NextRecord ();
+
+        /*
+         *--------------------------------------------------------------------------------------
+         *       Class:  FileScanner
+         *      Method:  FileScanner :: ReadNumber
+         * Description:  Returns the next number on the line.
+         *--------------------------------------------------------------------------------------
+         */
+        unsigned int ReadNumber ();
+
+        /*
+         *--------------------------------------------------------------------------------------
+         *       Class:  FileScanner
+         *      Method:  FileScanner :: EndRecord
+         * Description:  Checks that nothing but spaces is left on the line.
+         *--------------------------------------------------------------------------------------
+         */
+        void EndRecord ();
+
+        /*
+         *--------------------------------------------------------------------------------------
+         *       Class:  FileScanner
+         *      Method:  FileScanner :: Error
+         * Description:  Reports the message at the line and column of the last number
+         *               read, or of the text that could not be read, and exits.
+         *--------------------------------------------------------------------------------------
+         */
+        void Error (const char *inMessage);
+
+    private:
+        char            *fileName;      // For the error messages.
+        const char      *fileData;      // The mapped file.
+        size_t          fileSize;
+        const char      *position;      // Next character to read.
+        const char      *fileEnd;
+        const char      *lineStart;     // First character of the current line.
+        const char      *tokenStart;    // First character of the last number read.
+        unsigned int    lineNumber;     // Current line, from 1.
+
+        void    SkipSpaces ();
+};
+
+} /* namespace nameSpace_ATPG */
+#endif /* FILESCANNER_H_ */
@@ -0,0 +1,201 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  ImplicationEngine.cc
+ *
+ *    Description:  This file defines the methods in the ImplicationEngine class.
+ *                  The class implies one line value forward and backward through
+ *                  the fault free circuit.
+ *
+ *        Version:  1.0
+ *        Created:  12/02/2011
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  Aditya Shevade <aditya.shevade@gmail.com>,
+ *                  Amey Marathe <marathe.amey@gmail.com>,
+ *                  Samik Biswas <samiksb@gmail.com>,
+ *                  Viraj Bhogle <viraj.bhogle@gmail.com>
+ *
+ * =====================================================================================
+ */
+
+#include "ImplicationEngine.h"
+
+// Global constants are defined in this file.
+
+#ifndef GLOBAL_DEFINES_H_
+#include "../include/global_defines.h"
+#endif
+
+namespace nameSpace_ATPG {
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  ImplicationEngine
+ *      Method:  ImplicationEngine :: ImplicationEngine
+ * Description:  Takes in the node list of the circuit and its graph. The circuit
+ *               must already be levelized.
+ *--------------------------------------------------------------------------------------
+ */
+ImplicationEngine::ImplicationEngine (vector <CircuitNode> &inNodeList, CircuitGraph &inGraph) : nodeList (inNodeList), graph (inGraph) {
+
+    this->staticLearning = NULL;
+
+    nodeValue.assign(nodeList.size(), X);
+    isConflict = false;
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  ImplicationEngine
+ *      Method:  ImplicationEngine :: Assign
+ * Description:  Gives the node a value. A node that already has the other value is a
+ *               conflict.
+ *--------------------------------------------------------------------------------------
+ */
+void ImplicationEngine::Assign (int inNode, int inValue) {
+
+    if (nodeValue[inNode] == inValue)
+        return;
+    if (nodeValue[inNode] != X) {
+        isConflict = true;
+        return;
+    }
+
+    nodeValue[inNode] = inValue;
+    impliedNodes.push_back(inNode);
+    pendingNodes.push_back(inNode);
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  ImplicationEngine
+ *      Method:  ImplicationEngine :: ImplyBackward
+ * Description:  Sets the inputs of the gate that its output value forces.
+ *--------------------------------------------------------------------------------------
+ */
+void ImplicationEngine::ImplyBackward (int inNode) {
+
+    int outValue = nodeValue[inNode];
+    int firstInput = graph.fanInStart[inNode];
+    int lastInput = graph.fanInStart[inNode + 1];
+
+    if (outValue == X || firstInput == lastInput)
+        return;
+
+    unsigned int gateType = nodeList[inNode].gateType;
+    if (gateType == INV || gateType == NAND || gateType == NOR || gateType == XNOR)
+        outValue = 1 - outValue;
+
+    switch (gateType) {
+        case BRNCH:
+        case INV:
+            Assign(graph.fanInList[firstInput], outValue);
+            break;
+        case AND:
+        case NAND:
+        case OR:
+        case NOR: {
+            int controlValue = (gateType == AND || gateType == NAND) ? ZERO : ONE;
+            if (outValue != controlValue) {
+                for (int j = firstInput; j < lastInput; j++) {
+                    Assign(graph.fanInList[j], 1 - controlValue);
+                }
+                break;
+            }
+
+            // Controlled output, find the inputs that can still control it.
+            int freeInput = -1;
+            for (int j = firstInput; j < lastInput; j++) {
+                int inValue = nodeValue[graph.fanInList[j]];
+                if (inValue == controlValue)
+                    return;
+                if (inValue == X) {
+                    if (freeInput >= 0)
+                        return;
+                    freeInput = graph.fanInList[j];
+                }
+            }
+            if (freeInput >= 0)
+                Assign(freeInput, controlValue);
+            else
+                isConflict = true;
+            break;
+        }
+        case XOR:
+        case XNOR: {
+            int freeInput = -1;
+            for (int j = firstInput; j < lastInput; j++) {
+                int inValue = nodeValue[graph.fanInList[j]];
+                if (inValue == X) {
+                    if (freeInput >= 0)
+                        return;
+                    freeInput = graph.fanInList[j];
+                }
+                else
+                    outValue ^= inValue;
+            }
+            if (freeInput >= 0)
+                Assign(freeInput, outValue);
+            break;
+        }
+    }
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  ImplicationEngine
+ *      Method:  ImplicationEngine :: Imply
+ * Description:  Sets the node to the value and implies it through the circuit.
+ *               Returns false on a conflict.
+ *
+ *               Every node that gets a value is implied backward to its inputs,
+ *               forward to its fan out gates, and through the learnt implications.
+ *               A fan out gate that already has a value is implied backward again,
+ *               since one more known input can force the last one.
+ *--------------------------------------------------------------------------------------
+ */
+bool ImplicationEngine::Imply (int inNode, int inValue) {
+
+    for (int i = 0; i < impliedNodes.size(); i++) {
+        nodeValue[impliedNodes[i]] = X;
+    }
+    impliedNodes.clear();
+    pendingNodes.clear();
+    isConflict = false;
+
+    Assign(inNode, inValue);
+
+    while (!pendingNodes.empty() && !isConflict) {
+        int thisNode = pendingNodes.back();
+        pendingNodes.pop_back();
+
+        ImplyBackward(thisNode);
+
+        for (int j = graph.fanOutStart[thisNode]; j < graph.fanOutStart[thisNode + 1]; j++) {
+            int nextNode = graph.fanOutList[j];
+            int firstInput = graph.fanInStart[nextNode];
+            int newValue = evaluateGate(nodeList[nextNode].gateType, &nodeValue[0], &graph.fanInList[firstInput],
+                                        graph.fanInStart[nextNode + 1] - firstInput);
+            if (newValue != X)
+                Assign(nextNode, newValue);
+            else
+                ImplyBackward(nextNode);
+        }
+
+        if (staticLearning != NULL) {
+            int thisLiteral = StaticLearning::Literal(thisNode, nodeValue[thisNode]);
+            if (staticLearning->isImpossible[thisLiteral])
+                isConflict = true;
+            for (int k = staticLearning->literalStart[thisLiteral]; k < staticLearning->literalStart[thisLiteral + 1]; k++) {
+                int impliedLiteral = staticLearning->impliedLiterals[k];
+                Assign(impliedLiteral >> 1, impliedLiteral & 1);
+            }
+        }
+    }
+
+    return !isConflict;
+}
+
+} /* namespace nameSpace_ATPG */
@@ -0,0 +1,97 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  ImplicationEngine.h
+ *
+ *    Description:  The ImplicationEngine class. This class finds the values that one
+ *                  line value forces on the rest of the fault free circuit.
+ *
+ *                  Values are implied forward through the gates, as in simulation,
+ *                  and backward, from a gate output to its inputs when there is only
+ *                  one way to get that output. With a StaticLearning the learnt
+ *                  implications are followed too.
+ *
+ *        Version:  1.0
+ *        Created:  12/02/2011
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  Aditya Shevade <aditya.shevade@gmail.com>,
+ *                  Amey Marathe <marathe.amey@gmail.com>,
+ *                  Samik Biswas <samiksb@gmail.com>,
+ *                  Viraj Bhogle <viraj.bhogle@gmail.com>
+ *
+ * =====================================================================================
+ */
+
+#ifndef IMPLICATIONENGINE_H_
+#define IMPLICATIONENGINE_H_
+
+namespace nameSpace_ATPG {
+
+
+/*
+ * =====================================================================================
+ *        Class:  ImplicationEngine
+ *  Description:  Values are ZERO, ONE or X. Imply starts from all X every time, so one
+ *                object is used for any number of calls, but only by one thread.
+ *
+ *                Backward implication sets the inputs of a gate when its output
+ *                needs all of them (1 at an AND, 0 at an OR, and the same for the
+ *                inverting gates), when its output is controlled and only one input
+ *                is left that can control it, and for the one X input of an XOR.
+ * =====================================================================================
+ */
+class ImplicationEngine {
+    public:
+        StaticLearning      *staticLearning;    // Learnt implications, NULL for none.
+        vector <int>        impliedNodes;       // Nodes given a value by the last Imply.
+
+        /*
+         *--------------------------------------------------------------------------------------
+         *       Class:  ImplicationEngine
+         *      Method:  ImplicationEngine :: ImplicationEngine
+         * Description:  Takes in the node list of the circuit and its graph. The circuit
+         *               must already be levelized.
+         *--------------------------------------------------------------------------------------
+         */
+        ImplicationEngine (vector <CircuitNode> &inNodeList, CircuitGraph &inGraph);
+
+        /*
+         *--------------------------------------------------------------------------------------
+         *       Class:  ImplicationEngine
+         *      Method:  ImplicationEngine :: Imply
+         * Description:  Sets the node to the value (ZERO or ONE) and implies it through
+         *               the circuit. Returns false if some line is forced to both values,
+         *               that is if the node can never have that value. Otherwise
+         *               impliedNodes has every node with a value, the given one first,
+         *               and Value gives the values.
+         *--------------------------------------------------------------------------------------
+         */
+        bool Imply (int inNode, int inValue);
+
+        /*
+         *--------------------------------------------------------------------------------------
+         *       Class:  ImplicationEngine
+         *      Method:  ImplicationEngine :: Value
+         * Description:  Returns the value of the node after the last Imply.
+         *--------------------------------------------------------------------------------------
+         */
+        int Value (int inNode) {
+            return nodeValue[inNode];
+        }
+
+    private:
+        vector <CircuitNode>        &nodeList;      // The circuit, read only.
+        CircuitGraph                &graph;         // Fan in and fan out of the nodes, read only.
+
+        vector <int>                nodeValue;      // ZERO, ONE or X.
+        vector <int>                pendingNodes;   // Nodes whose new value is not implied yet.
+        bool                        isConflict;
+
+        void    Assign (int inNode, int inValue);
+        void    ImplyBackward (int inNode);
+};
+
+} /* namespace nameSpace_ATPG */
+#endif /* IMPLICATIONENGINE_H_ */
@@ -0,0 +1,87 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  PatternGenerator.cc
+ *
+ *    Description:  This file defines the methods in the PatternGenerator class.
+ *                  The class produces pseudo random input vectors from a seed.
+ *
+ *        Version:  1.0
+ *        Created:  12/02/2011
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  Aditya Shevade <aditya.shevade@gmail.com>,
+ *                  Amey Marathe <marathe.amey@gmail.com>,
+ *                  Samik Biswas <samiksb@gmail.com>,
+ *                  Viraj Bhogle <viraj.bhogle@gmail.com>
+ *
+ * =====================================================================================
+ */
+
+#include "PatternGenerator.h"
+
+// Global constants are defined in this file.
+
+#ifndef GLOBAL_DEFINES_H_
+#include "../include/global_defines.h"
+#endif
+
+namespace nameSpace_ATPG {
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  PatternGenerator
+ *      Method:  PatternGenerator :: PatternGenerator
+ * Description:  Takes in the number of primary inputs and the seed.
+ *--------------------------------------------------------------------------------------
+ */
+PatternGenerator::PatternGenerator (int inTotalInputs, uint64_t inSeed) {
+
+    totalInputs = inTotalInputs;
+
+    randomState = inSeed + 0x9E3779B97F4A7C15ULL;
+    randomState = (randomState ^ (randomState >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    randomState = (randomState ^ (randomState >> 27)) * 0x94D049BB133111EBULL;
+    randomState = randomState ^ (randomState >> 31);
+    if (randomState == 0)
+        randomState = 1;
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  PatternGenerator
+ *      Method:  PatternGenerator :: NextWord
+ * Description:  Returns the next 64 random bits.
+ *--------------------------------------------------------------------------------------
+ */
+uint64_t PatternGenerator::NextWord () {
+
+    randomState ^= randomState >> 12;
+    randomState ^= randomState << 25;
+    randomState ^= randomState >> 27;
+    return randomState * 0x2545F4914F6CDD1DULL;
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  PatternGenerator
+ *      Method:  PatternGenerator :: NextVector
+ * Description:  Writes the next vector to outVector, one character (0 or 1) per
+ *               primary input.
+ *--------------------------------------------------------------------------------------
+ */
+void PatternGenerator::NextVector (string &outVector) {
+
+    uint64_t randomBits = 0;
+
+    outVector.resize(totalInputs);
+    for (int i = 0; i < totalInputs; i++) {
+        if ((i & 63) == 0)
+            randomBits = NextWord();
+        outVector[i] = '0' + (randomBits & 1);
+        randomBits >>= 1;
+    }
+}
+
+} /* namespace nameSpace_ATPG */
@@ -0,0 +1,69 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  PatternGenerator.h
+ *
+ *    Description:  The PatternGenerator class. This class produces pseudo random input
+ *                  vectors for the random pattern phase of test generation.
+ *
+ *                  The vectors only depend on the seed, so a run can be repeated
+ *                  exactly on any machine.
+ *
+ *        Version:  1.0
+ *        Created:  12/02/2011
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  Aditya Shevade <aditya.shevade@gmail.com>,
+ *                  Amey Marathe <marathe.amey@gmail.com>,
+ *                  Samik Biswas <samiksb@gmail.com>,
+ *                  Viraj Bhogle <viraj.bhogle@gmail.com>
+ *
+ * =====================================================================================
+ */
+
+#ifndef PATTERNGENERATOR_H_
+#define PATTERNGENERATOR_H_
+
+namespace nameSpace_ATPG {
+
+
+/*
+ * =====================================================================================
+ *        Class:  PatternGenerator
+ *  Description:  A xorshift64* generator. The seed goes through one step of splitmix64
+ *                first, so that small seeds (and 0) give a good starting state. Every
+ *                64 bits of output give the values of 64 inputs.
+ * =====================================================================================
+ */
+class PatternGenerator {
+    public:
+
+        /*
+         *--------------------------------------------------------------------------------------
+         *       Class:  PatternGenerator
+         *      Method:  PatternGenerator :: PatternGenerator
+         * Description:  Takes in the number of primary inputs and the seed.
+         *--------------------------------------------------------------------------------------
+         */
+        PatternGenerator (int inTotalInputs, uint64_t inSeed);
+
+        /*
+         *--------------------------------------------------------------------------------------
+         *       Class:  PatternGenerator
+         *      Method:  PatternGenerator :: NextVector
+         * Description:  Writes the next vector to outVector, one character (0 or 1) per
+         *               primary input.
+         *--------------------------------------------------------------------------------------
+         */
+        void NextVector (string &outVector);
+
+    private:
+        int         totalInputs;
+        uint64_t    randomState;        // Never 0.
+
+        uint64_t    NextWord ();
+};
+
+} /* namespace nameSpace_ATPG */
+#endif /* PATTERNGENERATOR_H_ */
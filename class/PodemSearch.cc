@@ -0,0 +1,826 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  PodemSearch.cc
+ *
+ *    Description:  This file defines the methods in the PodemSearch class.
+ *                  The class generates a test for one stuck at fault at a time using
+ *                  the PODEM algorithm.
+ *
+ *        Version:  1.0
+ *        Created:  12/02/2011
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  Aditya Shevade <aditya.shevade@gmail.com>,
+ *                  Amey Marathe <marathe.amey@gmail.com>,
+ *                  Samik Biswas <samiksb@gmail.com>,
+ *                  Viraj Bhogle <viraj.bhogle@gmail.com>
+ *
+ * =====================================================================================
+ */
+
+#include "PodemSearch.h"
+
+// Global constants are defined in this file.
+
+#ifndef GLOBAL_DEFINES_H_
+#include "../include/global_defines.h"
+#endif
+
+namespace nameSpace_ATPG {
+
+/*
+ * Return values of CheckSearchState.
+ */
+#define SEARCH_FAIL     -1  // Fault is not excited or cannot reach an output.
+#define SEARCH_CONTINUE 0   // More inputs have to be assigned.
+#define SEARCH_SUCCESS  1   // D or Dbar is at a primary output.
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  PodemSearch
+ *      Method:  PodemSearch :: PodemSearch
+ * Description:  Takes in the node list of the circuit and its graph. The circuit
+ *               must already be levelized.
+ *--------------------------------------------------------------------------------------
+ */
+PodemSearch::PodemSearch (vector <CircuitNode> &inNodeList, CircuitGraph &inGraph) : nodeList (inNodeList), graph (inGraph),
+                                                                                     implicationEngine (inNodeList, inGraph) {
+
+    int totalNodes = nodeList.size();
+
+    this->totalDecisions = 0;
+    this->totalBacktracks = 0;
+    this->totalPrunes = 0;
+    this->staticLearning = NULL;
+    this->isFanSearch = false;
+    this->backtrackLimit = 0;
+    this->timeLimit = 0;
+    this->stopTime = chrono::steady_clock::time_point::max();
+
+    inputPosition.assign(totalNodes, -1);
+    for (int i = 0; i < graph.inputNodes.size(); i++) {
+        inputPosition[graph.inputNodes[i]] = i;
+    }
+
+    nodeValue.assign(totalNodes, X);
+    levelQueue.resize(graph.maxLevel + 1);
+    isQueued.assign(totalNodes, false);
+    visitMark.assign(totalNodes, 0);
+    visitStamp = 0;
+    deadMark.assign(totalNodes, 0);
+    deadStamp = 0;
+    faultNode = -1;
+    frontierNode = -1;
+    isExtending = false;
+
+    isInCone.assign(totalNodes, false);
+    countZero.assign(totalNodes, 0);
+    countOne.assign(totalNodes, 0);
+    FindHeadlines();
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  PodemSearch
+ *      Method:  PodemSearch :: FindHeadlines
+ * Description:  A line is bound if a fan out stem (a node with more than one fan out)
+ *               is in its fan in, and free otherwise. The fan in of a free line is a
+ *               tree of primary inputs that reach nothing else, so any value it
+ *               needs can be set later without a conflict. A headline is a free line
+ *               that is a stem, a primary output, or feeds a bound line.
+ *--------------------------------------------------------------------------------------
+ */
+void PodemSearch::FindHeadlines () {
+
+    vector <bool> isBound (nodeList.size(), false);
+
+    for (int i = 0; i < graph.levelOrder.size(); i++) {
+        int thisNode = graph.levelOrder[i];
+        for (int j = graph.fanInStart[thisNode]; j < graph.fanInStart[thisNode + 1]; j++) {
+            int prevNode = graph.fanInList[j];
+            if (isBound[prevNode] || graph.fanOutStart[prevNode + 1] - graph.fanOutStart[prevNode] > 1)
+                isBound[thisNode] = true;
+        }
+    }
+
+    isHeadline.assign(nodeList.size(), false);
+    for (int thisNode = 0; thisNode < nodeList.size(); thisNode++) {
+        int numberFanOut = graph.fanOutStart[thisNode + 1] - graph.fanOutStart[thisNode];
+        if (!isBound[thisNode] && (numberFanOut != 1 || isBound[graph.fanOutList[graph.fanOutStart[thisNode]]]))
+            isHeadline[thisNode] = true;
+    }
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  PodemSearch
+ *      Method:  PodemSearch :: EvaluateNode
+ * Description:  Computes the value of a node from the current values of its inputs.
+ *               If the node is the fault site, the value is changed to D or Dbar
+ *               when the fault is excited.
+ *--------------------------------------------------------------------------------------
+ */
+int PodemSearch::EvaluateNode (int inNode) {
+
+    int firstInput = graph.fanInStart[inNode];
+    int numberInputs = graph.fanInStart[inNode + 1] - firstInput;
+    int result;
+
+    result = evaluateGate (nodeList[inNode].gateType, &nodeValue[0], &graph.fanInList[firstInput], numberInputs);
+
+    if (inNode == faultNode) {
+        if (result == ONE && faultValue == false)
+            result = D;
+        else if (result == ZERO && faultValue == true)
+            result = B;
+    }
+
+    return result;
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  PodemSearch
+ *      Method:  PodemSearch :: AssignInput
+ * Description:  Sets a primary input, or a headline in FAN mode, to the given value
+ *               (0, 1 or X) and implies the new value forward through the circuit.
+ *--------------------------------------------------------------------------------------
+ */
+void PodemSearch::AssignInput (int inNode, int inValue) {
+
+    if (inNode == faultNode) {
+        if (inValue == ONE && faultValue == false)
+            inValue = D;
+        else if (inValue == ZERO && faultValue == true)
+            inValue = B;
+    }
+
+    if (nodeValue[inNode] != inValue) {
+        nodeValue[inNode] = inValue;
+        ImplyFrom(inNode);
+    }
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  PodemSearch
+ *      Method:  PodemSearch :: ImplyFrom
+ * Description:  Forward implication after the value of one node changed. Only the
+ *               nodes whose inputs changed are evaluated, one level at a time.
+ *--------------------------------------------------------------------------------------
+ */
+void PodemSearch::ImplyFrom (int inNode) {
+
+    for (int j = graph.fanOutStart[inNode]; j < graph.fanOutStart[inNode + 1]; j++) {
+        int nextNode = graph.fanOutList[j];
+        if (!isQueued[nextNode]) {
+            isQueued[nextNode] = true;
+            levelQueue[nodeList[nextNode].lineLevel].push_back(nextNode);
+        }
+    }
+
+    for (int level = nodeList[inNode].lineLevel + 1; level < levelQueue.size(); level++) {
+        for (int i = 0; i < levelQueue[level].size(); i++) {
+            int thisNode = levelQueue[level][i];
+            isQueued[thisNode] = false;
+
+            int newValue = EvaluateNode(thisNode);
+            if (newValue == nodeValue[thisNode])
+                continue;
+            nodeValue[thisNode] = newValue;
+
+            for (int j = graph.fanOutStart[thisNode]; j < graph.fanOutStart[thisNode + 1]; j++) {
+                int nextNode = graph.fanOutList[j];
+                if (!isQueued[nextNode]) {
+                    isQueued[nextNode] = true;
+                    levelQueue[nodeList[nextNode].lineLevel].push_back(nextNode);
+                }
+            }
+        }
+        levelQueue[level].clear();
+    }
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  PodemSearch
+ *      Method:  PodemSearch :: HasXPath
+ * Description:  Returns true if there is a path of lines with value X from the given
+ *               node to any primary output.
+ *
+ *               Every search takes a new visitStamp. When a search fails, none of
+ *               the nodes it visited has a path, so they are marked with deadStamp
+ *               and not searched again during the current check. The nodes of a
+ *               search that succeeds are not marked.
+ *--------------------------------------------------------------------------------------
+ */
+bool PodemSearch::HasXPath (int inNode) {
+
+    vector <int> pathStack;
+
+    if (deadMark[inNode] == deadStamp)
+        return false;
+    visitStamp++;
+    visitMark[inNode] = visitStamp;
+    pathStack.push_back(inNode);
+    searchedNodes.clear();
+
+    while (!pathStack.empty()) {
+        int thisNode = pathStack.back();
+        pathStack.pop_back();
+        if (nodeList[thisNode].numberFanOut == 0)
+            return true;
+        searchedNodes.push_back(thisNode);
+        for (int j = graph.fanOutStart[thisNode]; j < graph.fanOutStart[thisNode + 1]; j++) {
+            int nextNode = graph.fanOutList[j];
+            if (nodeValue[nextNode] == X && visitMark[nextNode] != visitStamp && deadMark[nextNode] != deadStamp) {
+                visitMark[nextNode] = visitStamp;
+                pathStack.push_back(nextNode);
+            }
+        }
+    }
+
+    for (int i = 0; i < searchedNodes.size(); i++) {
+        deadMark[searchedNodes[i]] = deadStamp;
+    }
+    return false;
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  PodemSearch
+ *      Method:  PodemSearch :: CheckSearchState
+ * Description:  Checks if the fault is detected or can no longer be detected with
+ *               the current input values. Otherwise it returns the next objective,
+ *               a node and the value that node should get.
+ *
+ *               If the fault is not excited yet, the objective is to excite it.
+ *               Otherwise one gate is picked from the D-frontier (the gates with an
+ *               X output and a D or Dbar input) and the objective is to set one of
+ *               its X inputs to the non controlling value.
+ *
+ *               The D-frontier gate closest to the fault site (lowest level) is
+ *               propagated first, and among those the easiest one to observe (lowest
+ *               SCOAP co). All its X inputs have to be set, so the hardest one is
+ *               taken first.
+ *--------------------------------------------------------------------------------------
+ */
+int PodemSearch::CheckSearchState (int &outObjectiveNode, int &outObjectiveValue) {
+
+    int siteValue = nodeValue[faultNode];
+
+    deadStamp++;
+    frontierNode = -1;
+
+    if (siteValue == X) {
+        if (!HasXPath(faultNode))
+            return SEARCH_FAIL;
+        for (int i = 0; i < requiredNodes.size(); i++) {
+            int thisValue = nodeValue[requiredNodes[i]];
+            if (thisValue != X && thisValue != requiredValues[i]) {
+                totalPrunes++;
+                return SEARCH_FAIL;
+            }
+        }
+        outObjectiveNode = faultNode;
+        outObjectiveValue = (faultValue ? ZERO : ONE);
+        return SEARCH_CONTINUE;
+    }
+
+    if (siteValue != D && siteValue != B)
+        return SEARCH_FAIL;                         // Fault can not be excited.
+
+    // Only the nodes in the fan out cone of the fault site can carry D or Dbar.
+    for (int i = 0; i < faultCone.size(); i++) {
+        int thisNode = faultCone[i];
+        int thisValue = nodeValue[thisNode];
+
+        if (thisValue == D || thisValue == B) {
+            if (nodeList[thisNode].numberFanOut == 0)
+                return SEARCH_SUCCESS;
+            continue;
+        }
+        if (thisValue != X)
+            continue;
+
+        bool isFrontier = false;
+        for (int j = graph.fanInStart[thisNode]; j < graph.fanInStart[thisNode + 1]; j++) {
+            int inValue = nodeValue[graph.fanInList[j]];
+            if (inValue == D || inValue == B) {
+                isFrontier = true;
+                break;
+            }
+        }
+
+        if (isFrontier && (frontierNode < 0 || nodeList[thisNode].lineLevel < nodeList[frontierNode].lineLevel ||
+                           (nodeList[thisNode].lineLevel == nodeList[frontierNode].lineLevel &&
+                            nodeList[thisNode].co < nodeList[frontierNode].co))) {
+            if (HasXPath(thisNode))
+                frontierNode = thisNode;
+        }
+    }
+
+    if (frontierNode < 0)
+        return SEARCH_FAIL;                         // D-frontier is empty or blocked.
+
+    switch (nodeList[frontierNode].gateType) {
+        case AND:
+        case NAND:
+            outObjectiveValue = ONE;
+            break;
+        default:                                    // OR, NOR, XOR and XNOR.
+            outObjectiveValue = ZERO;
+            break;
+    }
+
+    outObjectiveNode = -1;
+    for (int j = graph.fanInStart[frontierNode]; j < graph.fanInStart[frontierNode + 1]; j++) {
+        int inputNode = graph.fanInList[j];
+        if (nodeValue[inputNode] != X)
+            continue;
+        if (outObjectiveNode < 0 || ControlCost(inputNode, outObjectiveValue) > ControlCost(outObjectiveNode, outObjectiveValue))
+            outObjectiveNode = inputNode;
+    }
+
+    return SEARCH_CONTINUE;
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  PodemSearch
+ *      Method:  PodemSearch :: Backtrace
+ * Description:  Maps an objective to a primary input assignment. Starting from the
+ *               objective node, it follows X inputs back to a primary input and
+ *               inverts the value at every inverting gate on the way.
+ *
+ *               When every input of the gate needs the value (1 at an AND, 0 at an
+ *               OR), the input that is hardest to set is followed, so that a
+ *               conflict shows up early. When one input is enough, the easiest one
+ *               is followed. The costs are the SCOAP controllabilities.
+ *--------------------------------------------------------------------------------------
+ */
+void PodemSearch::Backtrace (int &ioNode, int &ioValue) {
+
+    while (inputPosition[ioNode] < 0) {
+        unsigned int gateType = nodeList[ioNode].gateType;
+        int nextNode = -1;
+
+        if (gateType == INV || gateType == NAND || gateType == NOR || gateType == XNOR)
+            ioValue = 1 - ioValue;
+
+        bool isParity = (gateType == XOR || gateType == XNOR);
+        bool isAllNeeded = ((gateType == AND || gateType == NAND) && ioValue == ONE) ||
+                           ((gateType == OR || gateType == NOR) && ioValue == ZERO);
+        unsigned int nextCost = 0;
+
+        // For XOR the value needed on the X input depends on the known inputs.
+        for (int j = graph.fanInStart[ioNode]; j < graph.fanInStart[ioNode + 1]; j++) {
+            int inValue = nodeValue[graph.fanInList[j]];
+            if (inValue == X) {
+                int inputNode = graph.fanInList[j];
+                unsigned int inputCost = (isParity ? min(nodeList[inputNode].cc0, nodeList[inputNode].cc1) :
+                                                     ControlCost(inputNode, ioValue));
+                if (nextNode < 0 || (isAllNeeded ? inputCost > nextCost : inputCost < nextCost)) {
+                    nextNode = inputNode;
+                    nextCost = inputCost;
+                }
+            }
+            else if (gateType == XOR || gateType == XNOR) {
+                if (inValue == ONE || inValue == D)
+                    ioValue = 1 - ioValue;
+            }
+        }
+
+        ioNode = nextNode;
+    }
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  PodemSearch
+ *      Method:  PodemSearch :: EasiestInput
+ * Description:  Returns the X input of the gate that is easiest to set to the value,
+ *               by SCOAP controllability, or -1 if no input is X.
+ *--------------------------------------------------------------------------------------
+ */
+int PodemSearch::EasiestInput (int inNode, int inValue) {
+
+    int easiestNode = -1;
+    for (int j = graph.fanInStart[inNode]; j < graph.fanInStart[inNode + 1]; j++) {
+        int inputNode = graph.fanInList[j];
+        if (nodeValue[inputNode] != X)
+            continue;
+        if (easiestNode < 0 || ControlCost(inputNode, inValue) < ControlCost(easiestNode, inValue))
+            easiestNode = inputNode;
+    }
+    return easiestNode;
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  PodemSearch
+ *      Method:  PodemSearch :: AddObjective
+ * Description:  Adds inCount objectives for the value at the node, for the multiple
+ *               backtrace. A node is queued by its level when it first gets a count.
+ *--------------------------------------------------------------------------------------
+ */
+void PodemSearch::AddObjective (int inNode, int inValue, double inCount) {
+
+    if (inNode < 0 || inCount == 0)
+        return;
+
+    if (!isQueued[inNode]) {
+        isQueued[inNode] = true;
+        countZero[inNode] = countOne[inNode] = 0;
+        levelQueue[nodeList[inNode].lineLevel].push_back(inNode);
+    }
+    if (inValue == ONE)
+        countOne[inNode] += inCount;
+    else
+        countZero[inNode] += inCount;
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  PodemSearch
+ *      Method:  PodemSearch :: MajorityValue
+ * Description:  Returns the value that more objectives want at the node. On a tie,
+ *               the value that is easier to set.
+ *--------------------------------------------------------------------------------------
+ */
+int PodemSearch::MajorityValue (int inNode) {
+
+    if (countOne[inNode] != countZero[inNode])
+        return (countOne[inNode] > countZero[inNode] ? ONE : ZERO);
+    return (ControlCost(inNode, ONE) <= ControlCost(inNode, ZERO) ? ONE : ZERO);
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  PodemSearch
+ *      Method:  PodemSearch :: MultipleBacktrace
+ * Description:  FAN multiple backtrace. The objectives are all the X inputs of the
+ *               D-frontier gate (or the fault site, to excite the fault). They are
+ *               traced back one level at a time, highest level first, so a stem
+ *               has the counts of all its branches before it is reached.
+ *
+ *               When every input of a gate needs the value, all the X inputs get
+ *               the count. When one input is enough, only the easiest one gets it.
+ *               The tracing stops at the primary inputs and at the headlines
+ *               outside the fault cone. It also stops at the first stem that is
+ *               wanted at both values: that stem, with the value more objectives
+ *               want (the easier one on a tie), is then traced back on its own.
+ *
+ *               The decision returned in ioNode and ioValue is the final objective
+ *               wanted by the most objectives.
+ *--------------------------------------------------------------------------------------
+ */
+void PodemSearch::MultipleBacktrace (int &ioNode, int &ioValue) {
+
+    int startNode = ioNode;
+    int startValue = ioValue;
+    bool isFromStem = false;
+
+    while (true) {
+        if (frontierNode < 0 || isFromStem) {
+            AddObjective(startNode, startValue, 1);
+        } else {
+            for (int j = graph.fanInStart[frontierNode]; j < graph.fanInStart[frontierNode + 1]; j++) {
+                if (nodeValue[graph.fanInList[j]] == X)
+                    AddObjective(graph.fanInList[j], startValue, 1);
+            }
+        }
+
+        int bestNode = -1;
+        int bestValue = ONE;
+        double bestCount = 0;
+        int conflictStem = -1;
+
+        for (int level = levelQueue.size() - 1; level >= 0; level--) {
+            for (int i = 0; i < levelQueue[level].size(); i++) {
+                int thisNode = levelQueue[level][i];
+                double thisZero = countZero[thisNode];
+                double thisOne = countOne[thisNode];
+
+                if (conflictStem >= 0)
+                    continue;
+
+                // Final objectives, decisions are made here.
+                if (inputPosition[thisNode] >= 0 || (isHeadline[thisNode] && !isInCone[thisNode] && !isExtending)) {
+                    if (max(thisZero, thisOne) > bestCount) {
+                        bestNode = thisNode;
+                        bestValue = MajorityValue(thisNode);
+                        bestCount = max(thisZero, thisOne);
+                    }
+                    continue;
+                }
+
+                if (thisZero > 0 && thisOne > 0 && thisNode != startNode &&
+                    graph.fanOutStart[thisNode + 1] - graph.fanOutStart[thisNode] > 1) {
+                    conflictStem = thisNode;
+                    startValue = MajorityValue(thisNode);
+                    continue;
+                }
+
+                unsigned int gateType = nodeList[thisNode].gateType;
+                if (gateType == INV || gateType == NAND || gateType == NOR || gateType == XNOR)
+                    swap (thisZero, thisOne);
+
+                switch (gateType) {
+                    case AND:
+                    case NAND:
+                    case OR:
+                    case NOR: {
+                        int allValue = (gateType == AND || gateType == NAND) ? ONE : ZERO;
+                        double allCount = (allValue == ONE ? thisOne : thisZero);
+                        double anyCount = (allValue == ONE ? thisZero : thisOne);
+                        for (int j = graph.fanInStart[thisNode]; j < graph.fanInStart[thisNode + 1]; j++) {
+                            if (nodeValue[graph.fanInList[j]] == X)
+                                AddObjective(graph.fanInList[j], allValue, allCount);
+                        }
+                        AddObjective(EasiestInput(thisNode, 1 - allValue), 1 - allValue, anyCount);
+                        break;
+                    }
+                    case XOR:
+                    case XNOR: {
+                        // The other X inputs are taken as 0.
+                        int parity = ZERO;
+                        int easiestNode = -1;
+                        for (int j = graph.fanInStart[thisNode]; j < graph.fanInStart[thisNode + 1]; j++) {
+                            int inputNode = graph.fanInList[j];
+                            int inValue = nodeValue[inputNode];
+                            if (inValue == ONE || inValue == D)
+                                parity = 1 - parity;
+                            else if (inValue == X && (easiestNode < 0 ||
+                                     min(nodeList[inputNode].cc0, nodeList[inputNode].cc1) <
+                                     min(nodeList[easiestNode].cc0, nodeList[easiestNode].cc1)))
+                                easiestNode = inputNode;
+                        }
+                        AddObjective(easiestNode, parity, thisZero);
+                        AddObjective(easiestNode, 1 - parity, thisOne);
+                        break;
+                    }
+                    default:                        // BRNCH and INV.
+                        AddObjective(graph.fanInList[graph.fanInStart[thisNode]], ZERO, thisZero);
+                        AddObjective(graph.fanInList[graph.fanInStart[thisNode]], ONE, thisOne);
+                        break;
+                }
+            }
+            for (int i = 0; i < levelQueue[level].size(); i++) {
+                isQueued[levelQueue[level][i]] = false;
+            }
+            levelQueue[level].clear();
+        }
+
+        if (conflictStem >= 0) {
+            startNode = conflictStem;
+            isFromStem = true;
+            continue;
+        }
+
+        if (bestNode < 0) {
+            Backtrace(ioNode, ioValue);
+            return;
+        }
+        ioNode = bestNode;
+        ioValue = bestValue;
+        return;
+    }
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  PodemSearch
+ *      Method:  PodemSearch :: JustifyHeadline
+ * Description:  Sets the primary inputs in the fanout-free cone of a headline so that
+ *               the headline gets the value, in ioVector. Every line in the cone has
+ *               one fan out, so the inputs of one gate never share a primary input.
+ *--------------------------------------------------------------------------------------
+ */
+void PodemSearch::JustifyHeadline (int inNode, int inValue, string &ioVector) {
+
+    vector < pair <int, int> > justifyStack;
+    justifyStack.push_back(make_pair(inNode, inValue));
+
+    while (!justifyStack.empty()) {
+        int thisNode = justifyStack.back().first;
+        int thisValue = justifyStack.back().second;
+        justifyStack.pop_back();
+
+        if (inputPosition[thisNode] >= 0) {
+            ioVector[inputPosition[thisNode]] = '0' + thisValue;
+            continue;
+        }
+
+        unsigned int gateType = nodeList[thisNode].gateType;
+        int firstInput = graph.fanInStart[thisNode];
+        int lastInput = graph.fanInStart[thisNode + 1];
+        if (gateType == INV || gateType == NAND || gateType == NOR || gateType == XNOR)
+            thisValue = 1 - thisValue;
+
+        switch (gateType) {
+            case AND:
+            case NAND:
+            case OR:
+            case NOR: {
+                int allValue = (gateType == AND || gateType == NAND) ? ONE : ZERO;
+                if (thisValue == allValue) {
+                    for (int j = firstInput; j < lastInput; j++) {
+                        justifyStack.push_back(make_pair(graph.fanInList[j], allValue));
+                    }
+                    break;
+                }
+                int easiestNode = graph.fanInList[firstInput];
+                for (int j = firstInput; j < lastInput; j++) {
+                    if (ControlCost(graph.fanInList[j], thisValue) < ControlCost(easiestNode, thisValue))
+                        easiestNode = graph.fanInList[j];
+                }
+                justifyStack.push_back(make_pair(easiestNode, thisValue));
+                break;
+            }
+            case XOR:
+            case XNOR:
+                // All the inputs but the last are set to 0.
+                for (int j = firstInput; j < lastInput - 1; j++) {
+                    justifyStack.push_back(make_pair(graph.fanInList[j], ZERO));
+                }
+                justifyStack.push_back(make_pair(graph.fanInList[lastInput - 1], thisValue));
+                break;
+            default:                                // BRNCH and INV.
+                justifyStack.push_back(make_pair(graph.fanInList[firstInput], thisValue));
+                break;
+        }
+    }
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  PodemSearch
+ *      Method:  PodemSearch :: GenerateTest
+ * Description:  Runs PODEM for the given line number and stuck at value. If a test
+ *               is found it is written to outVector, one character per primary
+ *               input, with 4 for the inputs that were never assigned. Returns
+ *               FAULT_DETECTED, FAULT_REDUNDANT or FAULT_ABORTED.
+ *
+ *               Decisions are kept on a stack. When the search fails, the last
+ *               decision not yet tried both ways is flipped and all the decisions
+ *               after it are set back to X.
+ *
+ *               The clock is read once every 64 steps of the search, starting with
+ *               the first, so a search that starts after stopTime ends at once.
+ *
+ *               In FAN mode a decision can be a headline. Its cone is left X during
+ *               the search and only justified once the test is found.
+ *--------------------------------------------------------------------------------------
+ */
+int PodemSearch::GenerateTest (int inLineNumber, bool inStuckAtValue, string &outVector) {
+
+    faultNode = graph.FindNode(inLineNumber);
+    if (faultNode < 0)
+        return FAULT_REDUNDANT;
+
+    faultValue = inStuckAtValue;
+    fill (nodeValue.begin(), nodeValue.end(), X);
+
+    // Inputs fixed by ExtendTest. They are not decisions, so they are never undone.
+    if (isExtending) {
+        for (int i = 0; i < graph.inputNodes.size(); i++) {
+            if (outVector[i] == '0' + ZERO || outVector[i] == '0' + ONE)
+                AssignInput(graph.inputNodes[i], outVector[i] - '0');
+        }
+    }
+
+    // With static learning, find the values the fault site value forces.
+    requiredNodes.clear();
+    requiredValues.clear();
+    if (staticLearning != NULL) {
+        implicationEngine.staticLearning = staticLearning;
+        if (!implicationEngine.Imply(faultNode, faultValue ? ZERO : ONE))
+            return FAULT_REDUNDANT;
+        for (int i = 1; i < implicationEngine.impliedNodes.size(); i++) {
+            requiredNodes.push_back(implicationEngine.impliedNodes[i]);
+            requiredValues.push_back(implicationEngine.Value(implicationEngine.impliedNodes[i]));
+        }
+    }
+
+    // Collect the fan out cone of the fault site.
+    for (int i = 0; i < faultCone.size(); i++) {
+        isInCone[faultCone[i]] = false;
+    }
+    visitStamp++;
+    faultCone.clear();
+    faultCone.push_back(faultNode);
+    visitMark[faultNode] = visitStamp;
+    for (int i = 0; i < faultCone.size(); i++) {
+        int thisNode = faultCone[i];
+        isInCone[thisNode] = true;
+        for (int j = graph.fanOutStart[thisNode]; j < graph.fanOutStart[thisNode + 1]; j++) {
+            int nextNode = graph.fanOutList[j];
+            if (visitMark[nextNode] != visitStamp) {
+                visitMark[nextNode] = visitStamp;
+                faultCone.push_back(nextNode);
+            }
+        }
+    }
+
+    vector <int> decisionNode;
+    vector <int> decisionValue;
+    vector <bool> decisionFlipped;
+    unsigned long numberBacktracks = 0;
+    unsigned long numberSteps = 0;
+
+    chrono::steady_clock::time_point faultStopTime = stopTime;
+    if (timeLimit > 0) {
+        chrono::steady_clock::time_point limitTime = chrono::steady_clock::now() +
+            chrono::duration_cast <chrono::steady_clock::duration> (chrono::duration <double> (timeLimit));
+        if (limitTime < faultStopTime)
+            faultStopTime = limitTime;
+    }
+
+    while (true) {
+        if ((numberSteps++ & 63) == 0 && chrono::steady_clock::now() >= faultStopTime)
+            return FAULT_ABORTED;
+
+        int objectiveNode, objectiveValue;
+        int searchState = CheckSearchState(objectiveNode, objectiveValue);
+
+        if (searchState == SEARCH_SUCCESS)
+            break;
+
+        if (searchState == SEARCH_CONTINUE) {
+            if (isFanSearch)
+                MultipleBacktrace(objectiveNode, objectiveValue);
+            else
+                Backtrace(objectiveNode, objectiveValue);
+            decisionNode.push_back(objectiveNode);
+            decisionValue.push_back(objectiveValue);
+            decisionFlipped.push_back(false);
+            totalDecisions++;
+            AssignInput(objectiveNode, objectiveValue);
+            continue;
+        }
+
+        // Undo the decisions that were already tried both ways.
+        while (!decisionNode.empty() && decisionFlipped.back()) {
+            AssignInput(decisionNode.back(), X);
+            decisionNode.pop_back();
+            decisionValue.pop_back();
+            decisionFlipped.pop_back();
+        }
+        if (decisionNode.empty())
+            return FAULT_REDUNDANT;
+        if (backtrackLimit > 0 && numberBacktracks >= backtrackLimit)
+            return FAULT_ABORTED;
+
+        numberBacktracks++;
+        decisionFlipped.back() = true;
+        decisionValue.back() = 1 - decisionValue.back();
+        totalBacktracks++;
+        AssignInput(decisionNode.back(), decisionValue.back());
+    }
+
+    // Unassigned inputs stay X. The fault free value is used at the fault site.
+    outVector.assign(graph.inputNodes.size(), '0' + X);
+    for (int i = 0; i < graph.inputNodes.size(); i++) {
+        int thisValue = nodeValue[graph.inputNodes[i]];
+        if (thisValue == D)
+            thisValue = ONE;
+        else if (thisValue == B)
+            thisValue = ZERO;
+        outVector[i] = '0' + thisValue;
+    }
+
+    // FAN decisions at headlines still need their inputs.
+    for (int i = 0; i < decisionNode.size(); i++) {
+        if (inputPosition[decisionNode[i]] < 0)
+            JustifyHeadline(decisionNode[i], decisionValue[i], outVector);
+    }
+
+    return FAULT_DETECTED;
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  PodemSearch
+ *      Method:  PodemSearch :: ExtendTest
+ * Description:  GenerateTest with the 0 and 1 inputs of ioVector fixed. In FAN mode no
+ *               decision is made at a headline, since some inputs of its cone may be
+ *               fixed, and the multiple backtrace goes on to the inputs instead.
+ *--------------------------------------------------------------------------------------
+ */
+int PodemSearch::ExtendTest (int inLineNumber, bool inStuckAtValue, string &ioVector) {
+
+    string thisVector (ioVector);
+
+    isExtending = true;
+    int searchStatus = GenerateTest(inLineNumber, inStuckAtValue, thisVector);
+    isExtending = false;
+
+    if (searchStatus == FAULT_DETECTED)
+        ioVector = thisVector;
+    return searchStatus;
+}
+
+} /* namespace nameSpace_ATPG */
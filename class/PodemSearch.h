@@ -0,0 +1,166 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  PodemSearch.h
+ *
+ *    Description:  The PodemSearch class. This class implements the PODEM (Path
+ *                  Oriented DEcision Making) test generation algorithm for a single
+ *                  stuck at fault.
+ *
+ *                  Only the primary inputs are ever assigned. Every decision is
+ *                  followed by forward implication, and the search backtracks when
+ *                  the fault can no longer be excited or no X-path is left from the
+ *                  D-frontier to a primary output.
+ *
+ *        Version:  1.0
+ *        Created:  12/02/2011
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  Aditya Shevade <aditya.shevade@gmail.com>,
+ *                  Amey Marathe <marathe.amey@gmail.com>,
+ *                  Samik Biswas <samiksb@gmail.com>,
+ *                  Viraj Bhogle <viraj.bhogle@gmail.com>
+ *
+ * =====================================================================================
+ */
+
+#ifndef PODEMSEARCH_H_
+#define PODEMSEARCH_H_
+
+namespace nameSpace_ATPG {
+
+
+/*
+ * =====================================================================================
+ *        Class:  PodemSearch
+ *  Description:  One object of this class is created for the circuit. It keeps its
+ *                own copy of the line values, so the node list is only read.
+ *                The SCOAP values of the nodes (see CircuitGraph :: ComputeTestability)
+ *                guide the choice of objectives and the backtrace.
+ *
+ *                GenerateTest is called once per fault. It returns FAULT_DETECTED and
+ *                the test vector if the fault can be detected, FAULT_REDUNDANT if the
+ *                fault is redundant, and FAULT_ABORTED if a limit was hit first.
+ *
+ *                The limits are per fault, a number of backtracks and a time in
+ *                seconds, 0 for no limit. stopTime ends every search that is still
+ *                running at that time, for a budget on the whole run.
+ *
+ *                With isFanSearch the search is FAN instead. The decisions are made at
+ *                the headlines, the lines where a fanout-free cone of the primary
+ *                inputs meets the rest of the circuit, as well as at the primary
+ *                inputs, and they are found by multiple backtrace: all the
+ *                objectives are traced back at once, with a count of how many want
+ *                each value, down to the headlines, the inputs, and the fan out
+ *                stems where the objectives disagree. A stem like that becomes the
+ *                objective of its own backtrace. Once a test is found the headlines
+ *                are justified inside their cones, which never conflicts.
+ *
+ *                With static learning, the values that exciting the fault forces on
+ *                the circuit are found before the search, through the learnt
+ *                implications too. If they conflict the fault is redundant, and
+ *                while the fault is not excited yet, an input assignment that gives
+ *                one of those lines the other value is a dead end.
+ *
+ *                ExtendTest is GenerateTest for a fault that should be detected by a
+ *                test that is already partly set, for dynamic compaction. The inputs
+ *                that are already 0 or 1 are fixed and only the X inputs are searched.
+ * =====================================================================================
+ */
+class PodemSearch {
+    public:
+        unsigned    long    totalDecisions;     // Primary input assignments, all faults.
+        unsigned    long    totalBacktracks;    // Decisions that had to be reversed.
+        unsigned    long    totalPrunes;        // Dead ends found by the learnt implications.
+        StaticLearning      *staticLearning;    // Learnt implications, NULL to not use them.
+        bool                isFanSearch;        // Use FAN instead of PODEM, false by default.
+
+        unsigned    long    backtrackLimit;     // Backtracks per fault, 0 for no limit.
+                    double  timeLimit;          // Seconds per fault, 0 for no limit.
+        chrono::steady_clock::time_point stopTime;  // No search goes on after this.
+
+        /*
+         *--------------------------------------------------------------------------------------
+         *       Class:  PodemSearch
+         *      Method:  PodemSearch :: PodemSearch
+         * Description:  Takes in the node list of the circuit and its graph. The circuit
+         *               must already be levelized.
+         *--------------------------------------------------------------------------------------
+         */
+        PodemSearch (vector <CircuitNode> &inNodeList, CircuitGraph &inGraph);
+
+        /*
+         *--------------------------------------------------------------------------------------
+         *       Class:  PodemSearch
+         *      Method:  PodemSearch :: GenerateTest
+         * Description:  Runs PODEM for the given line number and stuck at value. If a test
+         *               is found it is written to outVector, one character per primary
+         *               input, with 4 for the inputs that were never assigned. Returns
+         *               FAULT_DETECTED, FAULT_REDUNDANT or FAULT_ABORTED.
+         *--------------------------------------------------------------------------------------
+         */
+        int GenerateTest (int inLineNumber, bool inStuckAtValue, string &outVector);
+
+        /*
+         *--------------------------------------------------------------------------------------
+         *       Class:  PodemSearch
+         *      Method:  PodemSearch :: ExtendTest
+         * Description:  Same as GenerateTest, but the search starts from the inputs that
+         *               are 0 or 1 in ioVector and never changes them. If a test is found
+         *               the X inputs it needs are set in ioVector, otherwise ioVector is
+         *               left as it was. FAULT_REDUNDANT only means that there is no test
+         *               with those inputs.
+         *--------------------------------------------------------------------------------------
+         */
+        int ExtendTest (int inLineNumber, bool inStuckAtValue, string &ioVector);
+
+    private:
+        vector <CircuitNode>        &nodeList;      // The circuit, read only.
+        CircuitGraph                &graph;         // Fan in and fan out of the nodes, read only.
+        vector <int>                inputPosition;  // Position in the vector, -1 if not an input.
+        vector <int>                nodeValue;      // Current 5 valued value of each node.
+
+        vector < vector <int> >     levelQueue;     // Nodes waiting for evaluation, by level.
+        vector <bool>               isQueued;       // True if the node is in levelQueue.
+        vector <int>                faultCone;      // Transitive fan out of the fault site.
+        vector <unsigned int>       visitMark;      // Marks for the X-path search.
+        unsigned    int             visitStamp;
+        vector <unsigned int>       deadMark;       // Nodes without an X-path, in the current check.
+        unsigned    int             deadStamp;
+        vector <int>                searchedNodes;  // Nodes visited by the current X-path search.
+
+        int                         faultNode;      // Node index of the fault site.
+        bool                        faultValue;     // Stuck at value of the fault.
+        int                         frontierNode;   // D-frontier gate of the last objective.
+        bool                        isExtending;    // True inside ExtendTest.
+
+        vector <bool>               isHeadline;     // Free line that feeds a bound line or output.
+        vector <bool>               isInCone;       // True for the nodes in faultCone.
+        vector <double>             countZero;      // Objectives for 0 at each node, multiple backtrace.
+        vector <double>             countOne;       // Objectives for 1.
+
+        ImplicationEngine           implicationEngine;
+        vector <int>                requiredNodes;  // Values forced by exciting the fault,
+        vector <int>                requiredValues; // with static learning only.
+
+        void    AssignInput (int inNode, int inValue);
+        void    ImplyFrom (int inNode);
+        int     EvaluateNode (int inNode);
+        int     CheckSearchState (int &outObjectiveNode, int &outObjectiveValue);
+        bool    HasXPath (int inNode);
+        void    Backtrace (int &ioNode, int &ioValue);
+        void    FindHeadlines ();
+        void    AddObjective (int inNode, int inValue, double inCount);
+        void    MultipleBacktrace (int &ioNode, int &ioValue);
+        void    JustifyHeadline (int inNode, int inValue, string &ioVector);
+        int     EasiestInput (int inNode, int inValue);
+        int     MajorityValue (int inNode);
+
+        unsigned int ControlCost (int inNode, int inValue) {
+            return (inValue == ONE ? nodeList[inNode].cc1 : nodeList[inNode].cc0);
+        }
+};
+
+} /* namespace nameSpace_ATPG */
+#endif /* PODEMSEARCH_H_ */
@@ -0,0 +1,299 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  SatAtpg.cc
+ *
+ *    Description:  This file defines the methods in the SatAtpg class.
+ *                  The class generates a test for one stuck at fault at a time by
+ *                  solving a SAT problem.
+ *
+ *        Version:  1.0
+ *        Created:  12/02/2011
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  Aditya Shevade <aditya.shevade@gmail.com>,
+ *                  Amey Marathe <marathe.amey@gmail.com>,
+ *                  Samik Biswas <samiksb@gmail.com>,
+ *                  Viraj Bhogle <viraj.bhogle@gmail.com>
+ *
+ * =====================================================================================
+ */
+
+#include "SatAtpg.h"
+
+// Global constants are defined in this file.
+
+#ifndef GLOBAL_DEFINES_H_
+#include "../include/global_defines.h"
+#endif
+
+namespace nameSpace_ATPG {
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  SatAtpg
+ *      Method:  SatAtpg :: SatAtpg
+ * Description:  Takes in the node list of the circuit and its graph. The circuit
+ *               must already be levelized.
+ *--------------------------------------------------------------------------------------
+ */
+SatAtpg::SatAtpg (vector <CircuitNode> &inNodeList, CircuitGraph &inGraph) : nodeList (inNodeList), graph (inGraph) {
+
+    this->totalDecisions = 0;
+    this->totalConflicts = 0;
+    this->conflictLimit = 0;
+    this->timeLimit = 0;
+    this->stopTime = chrono::steady_clock::time_point::max();
+
+    goodVariable.assign(nodeList.size(), -1);
+    faultVariable.assign(nodeList.size(), -1);
+    effectVariable.assign(nodeList.size(), -1);
+    visitMark.assign(nodeList.size(), 0);
+    visitStamp = 0;
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  SatAtpg
+ *      Method:  SatAtpg :: AddGate
+ * Description:  Adds the clauses that make the literal inOutput the value of the gate
+ *               for the input literals in inInputs.
+ *
+ *               An inverting gate is the same as the gate without the inversion on
+ *               the negated output. An XOR of more than two inputs is a chain of two
+ *               input XORs, with a new variable for each link.
+ *--------------------------------------------------------------------------------------
+ */
+void SatAtpg::AddGate (SatSolver &ioSolver, int inGateType, int inOutput, vector <int> &inInputs) {
+
+    vector <int> clause;
+
+    if (inGateType == INV || inGateType == NAND || inGateType == NOR || inGateType == XNOR)
+        inOutput ^= 1;
+
+    switch (inGateType) {
+        case BRNCH:
+        case INV:
+            clause.assign(2, 0);
+            clause[0] = inOutput ^ 1;
+            clause[1] = inInputs[0];
+            ioSolver.AddClause(clause);
+            clause[0] = inOutput;
+            clause[1] = inInputs[0] ^ 1;
+            ioSolver.AddClause(clause);
+            break;
+        case AND:
+        case NAND:
+            // The output implies every input, all the inputs imply the output.
+            for (int i = 0; i < inInputs.size(); i++) {
+                clause.assign(2, 0);
+                clause[0] = inOutput ^ 1;
+                clause[1] = inInputs[i];
+                ioSolver.AddClause(clause);
+            }
+            clause.assign(1, inOutput);
+            for (int i = 0; i < inInputs.size(); i++) {
+                clause.push_back(inInputs[i] ^ 1);
+            }
+            ioSolver.AddClause(clause);
+            break;
+        case OR:
+        case NOR:
+            // Every input implies the output, the output implies some input.
+            for (int i = 0; i < inInputs.size(); i++) {
+                clause.assign(2, 0);
+                clause[0] = inOutput;
+                clause[1] = inInputs[i] ^ 1;
+                ioSolver.AddClause(clause);
+            }
+            clause.assign(1, inOutput ^ 1);
+            for (int i = 0; i < inInputs.size(); i++) {
+                clause.push_back(inInputs[i]);
+            }
+            ioSolver.AddClause(clause);
+            break;
+        case XOR:
+        case XNOR: {
+            int partial = inInputs[0];
+            if (inInputs.size() == 1) {
+                vector <int> single (1, partial);
+                AddGate(ioSolver, BRNCH, inOutput, single);
+                break;
+            }
+            for (int i = 1; i < inInputs.size(); i++) {
+                int link = (i == inInputs.size() - 1) ? inOutput : SatSolver::Literal(ioSolver.NewVariable(), false);
+                int a = partial, b = inInputs[i];
+                int xorClauses[4][3] = { { link ^ 1, a, b }, { link ^ 1, a ^ 1, b ^ 1 },
+                                         { link, a ^ 1, b }, { link, a, b ^ 1 } };
+                for (int k = 0; k < 4; k++) {
+                    clause.assign(xorClauses[k], xorClauses[k] + 3);
+                    ioSolver.AddClause(clause);
+                }
+                partial = link;
+            }
+            break;
+        }
+        default:
+            cerr << "Unknown gate type encountered." << endl;
+            cerr << "Possible values are 1-8. Current value is " << inGateType << endl;
+            exit(1);
+            break;
+    }
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  SatAtpg
+ *      Method:  SatAtpg :: GenerateTest
+ * Description:  Solves the problem for the given line number and stuck at value. If a
+ *               test is found it is written to outVector, one character per primary
+ *               input, with 4 for the inputs outside the fan in of the fault cone.
+ *               Returns FAULT_DETECTED, FAULT_REDUNDANT or FAULT_ABORTED.
+ *--------------------------------------------------------------------------------------
+ */
+int SatAtpg::GenerateTest (int inLineNumber, bool inStuckAtValue, string &outVector) {
+
+    int faultNode = graph.FindNode(inLineNumber);
+    if (faultNode < 0)
+        return FAULT_REDUNDANT;
+
+    // Collect the fan out cone of the fault site.
+    visitStamp++;
+    faultCone.clear();
+    faultCone.push_back(faultNode);
+    visitMark[faultNode] = visitStamp;
+    for (int i = 0; i < faultCone.size(); i++) {
+        int thisNode = faultCone[i];
+        for (int j = graph.fanOutStart[thisNode]; j < graph.fanOutStart[thisNode + 1]; j++) {
+            int nextNode = graph.fanOutList[j];
+            if (visitMark[nextNode] != visitStamp) {
+                visitMark[nextNode] = visitStamp;
+                faultCone.push_back(nextNode);
+            }
+        }
+    }
+
+    // Then everything the cone depends on, the cone included.
+    visitStamp++;
+    supportNodes.clear();
+    for (int i = 0; i < faultCone.size(); i++) {
+        visitMark[faultCone[i]] = visitStamp;
+        supportNodes.push_back(faultCone[i]);
+    }
+    for (int i = 0; i < supportNodes.size(); i++) {
+        int thisNode = supportNodes[i];
+        for (int j = graph.fanInStart[thisNode]; j < graph.fanInStart[thisNode + 1]; j++) {
+            int prevNode = graph.fanInList[j];
+            if (visitMark[prevNode] != visitStamp) {
+                visitMark[prevNode] = visitStamp;
+                supportNodes.push_back(prevNode);
+            }
+        }
+    }
+
+    // The cone nodes are at the start of supportNodes. Only they have a faulty value.
+    SatSolver solver;
+    vector <int> clause;
+    vector <int> gateInputs;
+
+    for (int i = 0; i < supportNodes.size(); i++) {
+        goodVariable[supportNodes[i]] = solver.NewVariable();
+    }
+    for (int i = 0; i < faultCone.size(); i++) {
+        faultVariable[faultCone[i]] = solver.NewVariable();
+        effectVariable[faultCone[i]] = solver.NewVariable();
+    }
+
+    for (int i = 0; i < supportNodes.size(); i++) {
+        int thisNode = supportNodes[i];
+        if (graph.fanInStart[thisNode] == graph.fanInStart[thisNode + 1])
+            continue;
+
+        gateInputs.clear();
+        for (int j = graph.fanInStart[thisNode]; j < graph.fanInStart[thisNode + 1]; j++) {
+            gateInputs.push_back(SatSolver::Literal(goodVariable[graph.fanInList[j]], false));
+        }
+        AddGate(solver, nodeList[thisNode].gateType, SatSolver::Literal(goodVariable[thisNode], false), gateInputs);
+
+        if (i >= faultCone.size() || thisNode == faultNode)
+            continue;
+
+        gateInputs.clear();
+        for (int j = graph.fanInStart[thisNode]; j < graph.fanInStart[thisNode + 1]; j++) {
+            int prevNode = graph.fanInList[j];
+            int prevVariable = (faultVariable[prevNode] >= 0) ? faultVariable[prevNode] : goodVariable[prevNode];
+            gateInputs.push_back(SatSolver::Literal(prevVariable, false));
+        }
+        AddGate(solver, nodeList[thisNode].gateType, SatSolver::Literal(faultVariable[thisNode], false), gateInputs);
+    }
+
+    // The fault is excited: the fault free value is the opposite of the stuck at value.
+    clause.assign(1, SatSolver::Literal(goodVariable[faultNode], inStuckAtValue));
+    solver.AddClause(clause);
+    clause.assign(1, SatSolver::Literal(faultVariable[faultNode], !inStuckAtValue));
+    solver.AddClause(clause);
+
+    // The fault effect goes from the fault site to a primary output.
+    for (int i = 0; i < faultCone.size(); i++) {
+        int thisNode = faultCone[i];
+        int effect = SatSolver::Literal(effectVariable[thisNode], false);
+        int good = SatSolver::Literal(goodVariable[thisNode], false);
+        int faulty = SatSolver::Literal(faultVariable[thisNode], false);
+
+        clause.assign(3, 0);
+        clause[0] = effect ^ 1;
+        clause[1] = good;
+        clause[2] = faulty;
+        solver.AddClause(clause);
+        clause[1] = good ^ 1;
+        clause[2] = faulty ^ 1;
+        solver.AddClause(clause);
+
+        if (graph.fanOutStart[thisNode] == graph.fanOutStart[thisNode + 1])
+            continue;
+        clause.assign(1, effect ^ 1);
+        for (int j = graph.fanOutStart[thisNode]; j < graph.fanOutStart[thisNode + 1]; j++) {
+            clause.push_back(SatSolver::Literal(effectVariable[graph.fanOutList[j]], false));
+        }
+        solver.AddClause(clause);
+    }
+    clause.assign(1, SatSolver::Literal(effectVariable[faultNode], false));
+    solver.AddClause(clause);
+
+    solver.conflictLimit = conflictLimit;
+    solver.stopTime = stopTime;
+    if (timeLimit > 0) {
+        chrono::steady_clock::time_point limitTime = chrono::steady_clock::now() +
+            chrono::duration_cast <chrono::steady_clock::duration> (chrono::duration <double> (timeLimit));
+        if (limitTime < solver.stopTime)
+            solver.stopTime = limitTime;
+    }
+
+    int solveResult = solver.Solve();
+    totalDecisions += solver.totalDecisions;
+    totalConflicts += solver.totalConflicts;
+
+    if (solveResult == SAT_SATISFIABLE) {
+        outVector.assign(graph.inputNodes.size(), '0' + X);
+        for (int i = 0; i < graph.inputNodes.size(); i++) {
+            int thisVariable = goodVariable[graph.inputNodes[i]];
+            if (thisVariable >= 0)
+                outVector[i] = '0' + (solver.ModelValue(thisVariable) ? ONE : ZERO);
+        }
+    }
+
+    for (int i = 0; i < supportNodes.size(); i++) {
+        goodVariable[supportNodes[i]] = -1;
+        faultVariable[supportNodes[i]] = -1;
+        effectVariable[supportNodes[i]] = -1;
+    }
+
+    if (solveResult == SAT_SATISFIABLE)
+        return FAULT_DETECTED;
+    if (solveResult == SAT_UNSATISFIABLE)
+        return FAULT_REDUNDANT;
+    return FAULT_ABORTED;
+}
+
+} /* namespace nameSpace_ATPG */
@@ -0,0 +1,100 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  SatAtpg.h
+ *
+ *    Description:  The SatAtpg class. This class generates a test for a single stuck
+ *                  at fault by solving a SAT problem.
+ *
+ *                  The fault free circuit and a copy of the fan out cone of the fault
+ *                  site with the fault in it are written as clauses, and a primary
+ *                  output is required to differ between the two. A solution is a
+ *                  test; if there is none the fault is redundant.
+ *
+ *        Version:  1.0
+ *        Created:  12/02/2011
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  Aditya Shevade <aditya.shevade@gmail.com>,
+ *                  Amey Marathe <marathe.amey@gmail.com>,
+ *                  Samik Biswas <samiksb@gmail.com>,
+ *                  Viraj Bhogle <viraj.bhogle@gmail.com>
+ *
+ * =====================================================================================
+ */
+
+#ifndef SATATPG_H_
+#define SATATPG_H_
+
+namespace nameSpace_ATPG {
+
+
+/*
+ * =====================================================================================
+ *        Class:  SatAtpg
+ *  Description:  One object of this class is created for the circuit. A new SatSolver
+ *                is made for every fault, with only the part of the circuit that
+ *                matters for it: the fan out cone of the fault site and everything in
+ *                the fan in of that cone.
+ *
+ *                Every line of the cone has a third variable, true where the line
+ *                carries the fault effect. The fault site carries it, and a line that
+ *                carries it must have a fan out that carries it too, unless it is a
+ *                primary output. These clauses are not needed for the answer, but
+ *                they make the solver find the dead ends much earlier.
+ *
+ *                GenerateTest returns FAULT_DETECTED, FAULT_REDUNDANT or FAULT_ABORTED
+ *                like PodemSearch :: GenerateTest, and the limits work the same way,
+ *                with conflicts in place of backtracks.
+ * =====================================================================================
+ */
+class SatAtpg {
+    public:
+        unsigned    long    totalDecisions;     // Solver decisions, all faults.
+        unsigned    long    totalConflicts;     // Solver conflicts, all faults.
+
+        unsigned    long    conflictLimit;      // Conflicts per fault, 0 for no limit.
+                    double  timeLimit;          // Seconds per fault, 0 for no limit.
+        chrono::steady_clock::time_point stopTime;  // No search goes on after this.
+
+        /*
+         *--------------------------------------------------------------------------------------
+         *       Class:  SatAtpg
+         *      Method:  SatAtpg :: SatAtpg
+         * Description:  Takes in the node list of the circuit and its graph. The circuit
+         *               must already be levelized.
+         *--------------------------------------------------------------------------------------
+         */
+        SatAtpg (vector <CircuitNode> &inNodeList, CircuitGraph &inGraph);
+
+        /*
+         *--------------------------------------------------------------------------------------
+         *       Class:  SatAtpg
+         *      Method:  SatAtpg :: GenerateTest
+         * Description:  Solves the problem for the given line number and stuck at value.
+         *               If a test is found it is written to outVector, one character per
+         *               primary input, with 4 for the inputs outside the fan in of the
+         *               fault cone. Returns FAULT_DETECTED, FAULT_REDUNDANT or
+         *               FAULT_ABORTED.
+         *--------------------------------------------------------------------------------------
+         */
+        int GenerateTest (int inLineNumber, bool inStuckAtValue, string &outVector);
+
+    private:
+        vector <CircuitNode>        &nodeList;      // The circuit, read only.
+        CircuitGraph                &graph;         // Fan in and fan out of the nodes, read only.
+
+        vector <int>                goodVariable;   // Fault free value of each node, -1 if none.
+        vector <int>                faultVariable;  // Faulty value of each cone node, -1 if none.
+        vector <int>                effectVariable; // Fault effect on each cone node, -1 if none.
+        vector <int>                faultCone;      // Transitive fan out of the fault site.
+        vector <int>                supportNodes;   // Transitive fan in of the cone.
+        vector <unsigned int>       visitMark;
+        unsigned    int             visitStamp;
+
+        void    AddGate (SatSolver &ioSolver, int inGateType, int inOutput, vector <int> &inInputs);
+};
+
+} /* namespace nameSpace_ATPG */
+#endif /* SATATPG_H_ */
@@ -0,0 +1,511 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  SatSolver.cc
+ *
+ *    Description:  This file defines the methods in the SatSolver class.
+ *                  The class is a small CDCL solver for formulas in conjunctive
+ *                  normal form.
+ *
+ *        Version:  1.0
+ *        Created:  12/02/2011
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  Aditya Shevade <aditya.shevade@gmail.com>,
+ *                  Amey Marathe <marathe.amey@gmail.com>,
+ *                  Samik Biswas <samiksb@gmail.com>,
+ *                  Viraj Bhogle <viraj.bhogle@gmail.com>
+ *
+ * =====================================================================================
+ */
+
+#include "SatSolver.h"
+
+// Global constants are defined in this file.
+
+#ifndef GLOBAL_DEFINES_H_
+#include "../include/global_defines.h"
+#endif
+
+namespace nameSpace_ATPG {
+
+#define SAT_ACTIVITY_DECAY  0.95    // Activity kept per conflict.
+#define SAT_RESTART_BASE    100     // Conflicts per unit of the Luby sequence.
+
+/*
+ * ===  FUNCTION  ======================================================================
+ *         Name:  lubySequence
+ *  Description:  Returns term inIndex (from 0) of the Luby sequence 1 1 2 1 1 2 4 ...
+ * =====================================================================================
+ */
+static unsigned long lubySequence (unsigned long inIndex) {
+
+    unsigned long size = 1;
+    int power = 0;
+    while (size < inIndex + 1) {
+        power++;
+        size = 2 * size + 1;
+    }
+    while (size - 1 != inIndex) {
+        size = (size - 1) >> 1;
+        power--;
+        inIndex = inIndex % size;
+    }
+    return 1UL << power;
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  SatSolver
+ *      Method:  SatSolver :: SatSolver
+ * Description:  Creates an empty formula, with no variables.
+ *--------------------------------------------------------------------------------------
+ */
+SatSolver::SatSolver () {
+
+    this->totalDecisions = 0;
+    this->totalConflicts = 0;
+    this->conflictLimit = 0;
+    this->stopTime = chrono::steady_clock::time_point::max();
+
+    isUnsatisfiable = false;
+    propagateHead = 0;
+    activityIncrement = 1;
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  SatSolver
+ *      Method:  SatSolver :: NewVariable
+ * Description:  Adds a variable and returns its number.
+ *--------------------------------------------------------------------------------------
+ */
+int SatSolver::NewVariable () {
+
+    int thisVariable = assignment.size();
+
+    assignment.push_back(-1);
+    decisionLevel.push_back(0);
+    reasonClause.push_back(-1);
+    savedValue.push_back(0);
+    isSeen.push_back(0);
+    activity.push_back(0);
+    heapPosition.push_back(-1);
+    watchList.resize(2 * assignment.size());
+    HeapInsert(thisVariable);
+
+    return thisVariable;
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  SatSolver
+ *      Method:  SatSolver :: LiteralValue
+ * Description:  Returns 1 if the literal is true, 0 if it is false and -1 if its
+ *               variable is not assigned.
+ *--------------------------------------------------------------------------------------
+ */
+int SatSolver::LiteralValue (int inLiteral) {
+
+    int thisValue = assignment[inLiteral >> 1];
+    if (thisValue < 0)
+        return -1;
+    return thisValue ^ (inLiteral & 1);
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  SatSolver
+ *      Method:  SatSolver :: Assign
+ * Description:  Makes the literal true at the current decision level. inReason is the
+ *               clause that implied it, -1 for a decision.
+ *--------------------------------------------------------------------------------------
+ */
+void SatSolver::Assign (int inLiteral, int inReason) {
+
+    int thisVariable = inLiteral >> 1;
+    assignment[thisVariable] = (inLiteral & 1) ? 0 : 1;
+    decisionLevel[thisVariable] = levelStart.size();
+    reasonClause[thisVariable] = inReason;
+    trail.push_back(inLiteral);
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  SatSolver
+ *      Method:  SatSolver :: AttachClause
+ * Description:  Stores a clause of two or more literals and watches its first two.
+ *               Returns the clause number.
+ *--------------------------------------------------------------------------------------
+ */
+int SatSolver::AttachClause (vector <int> &inLiterals) {
+
+    int thisClause = clauseStart.size();
+
+    clauseStart.push_back(clauseLiterals.size());
+    clauseSize.push_back(inLiterals.size());
+    clauseLiterals.insert(clauseLiterals.end(), inLiterals.begin(), inLiterals.end());
+    watchList[inLiterals[0]].push_back(thisClause);
+    watchList[inLiterals[1]].push_back(thisClause);
+
+    return thisClause;
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  SatSolver
+ *      Method:  SatSolver :: AddClause
+ * Description:  Adds the clause with the given literals. Repeated literals are
+ *               removed and a clause with both a literal and its negation is left
+ *               out. A clause of one literal is assigned at once, at level 0.
+ *--------------------------------------------------------------------------------------
+ */
+void SatSolver::AddClause (vector <int> &inLiterals) {
+
+    vector <int> thisClause (inLiterals);
+    sort (thisClause.begin(), thisClause.end());
+    thisClause.erase(unique(thisClause.begin(), thisClause.end()), thisClause.end());
+    for (int i = 1; i < thisClause.size(); i++) {
+        if (thisClause[i] == (thisClause[i - 1] ^ 1))
+            return;
+    }
+
+    if (thisClause.empty()) {
+        isUnsatisfiable = true;
+        return;
+    }
+
+    if (thisClause.size() == 1) {
+        int thisValue = LiteralValue(thisClause[0]);
+        if (thisValue == 0)
+            isUnsatisfiable = true;
+        else if (thisValue < 0)
+            Assign(thisClause[0], -1);
+        return;
+    }
+
+    AttachClause(thisClause);
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  SatSolver
+ *      Method:  SatSolver :: Propagate
+ * Description:  Unit propagation of the literals on the trail that were not
+ *               propagated yet. Returns the clause that has all its literals false, or
+ *               -1 if there is no conflict.
+ *
+ *               Only the clauses watching a literal that became false are visited.
+ *               The false watch is swapped to position 1, and is moved to any other
+ *               literal of the clause that is not false. If there is none, the clause
+ *               is unit (or in conflict) on the literal at position 0.
+ *--------------------------------------------------------------------------------------
+ */
+int SatSolver::Propagate () {
+
+    while (propagateHead < trail.size()) {
+        int falseLiteral = trail[propagateHead++] ^ 1;
+        vector <int> &thisWatchList = watchList[falseLiteral];
+        int kept = 0;
+
+        for (int i = 0; i < thisWatchList.size(); i++) {
+            int thisClause = thisWatchList[i];
+            int *literals = &clauseLiterals[clauseStart[thisClause]];
+            int numberLiterals = clauseSize[thisClause];
+
+            if (literals[0] == falseLiteral)
+                swap (literals[0], literals[1]);
+
+            if (LiteralValue(literals[0]) == 1) {
+                thisWatchList[kept++] = thisClause;
+                continue;
+            }
+
+            bool isMoved = false;
+            for (int k = 2; k < numberLiterals; k++) {
+                if (LiteralValue(literals[k]) != 0) {
+                    swap (literals[1], literals[k]);
+                    watchList[literals[1]].push_back(thisClause);
+                    isMoved = true;
+                    break;
+                }
+            }
+            if (isMoved)
+                continue;
+
+            thisWatchList[kept++] = thisClause;
+            if (LiteralValue(literals[0]) == 0) {
+                for (i++; i < thisWatchList.size(); i++) {
+                    thisWatchList[kept++] = thisWatchList[i];
+                }
+                thisWatchList.resize(kept);
+                propagateHead = trail.size();
+                return thisClause;
+            }
+            Assign(literals[0], thisClause);
+        }
+        thisWatchList.resize(kept);
+    }
+
+    return -1;
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  SatSolver
+ *      Method:  SatSolver :: Analyze
+ * Description:  Resolves the conflict clause with the reasons of the literals of the
+ *               current level, latest first, until one literal of the current level is
+ *               left (the first unique implication point). outLearnt gets the learnt
+ *               clause with the negation of that literal first and a literal of the
+ *               highest other level second. outLevel is that other level, 0 if the
+ *               clause has one literal.
+ *--------------------------------------------------------------------------------------
+ */
+void SatSolver::Analyze (int inConflict, vector <int> &outLearnt, int &outLevel) {
+
+    int currentLevel = levelStart.size();
+    int pathCount = 0;
+    int thisLiteral = -1;
+    int trailIndex = trail.size() - 1;
+    int thisClause = inConflict;
+
+    outLearnt.clear();
+    outLearnt.push_back(-1);
+
+    do {
+        int *literals = &clauseLiterals[clauseStart[thisClause]];
+        for (int k = 0; k < clauseSize[thisClause]; k++) {
+            int thisVariable = literals[k] >> 1;
+            if (literals[k] == thisLiteral || isSeen[thisVariable] || decisionLevel[thisVariable] == 0)
+                continue;
+            isSeen[thisVariable] = 1;
+            BumpActivity(thisVariable);
+            if (decisionLevel[thisVariable] == currentLevel)
+                pathCount++;
+            else
+                outLearnt.push_back(literals[k]);
+        }
+
+        while (!isSeen[trail[trailIndex] >> 1])
+            trailIndex--;
+        thisLiteral = trail[trailIndex--];
+        thisClause = reasonClause[thisLiteral >> 1];
+        isSeen[thisLiteral >> 1] = 0;
+        pathCount--;
+    } while (pathCount > 0);
+
+    outLearnt[0] = thisLiteral ^ 1;
+
+    outLevel = 0;
+    for (int k = 1; k < outLearnt.size(); k++) {
+        int thisVariable = outLearnt[k] >> 1;
+        isSeen[thisVariable] = 0;
+        if (decisionLevel[thisVariable] > outLevel) {
+            outLevel = decisionLevel[thisVariable];
+            swap (outLearnt[1], outLearnt[k]);
+        }
+    }
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  SatSolver
+ *      Method:  SatSolver :: Backtrack
+ * Description:  Unassigns every variable above the given decision level. The value
+ *               of each is saved for the next decision on it.
+ *--------------------------------------------------------------------------------------
+ */
+void SatSolver::Backtrack (int inLevel) {
+
+    if (levelStart.size() <= inLevel)
+        return;
+
+    for (int i = trail.size() - 1; i >= levelStart[inLevel]; i--) {
+        int thisVariable = trail[i] >> 1;
+        savedValue[thisVariable] = assignment[thisVariable];
+        assignment[thisVariable] = -1;
+        if (heapPosition[thisVariable] < 0)
+            HeapInsert(thisVariable);
+    }
+    trail.resize(levelStart[inLevel]);
+    levelStart.resize(inLevel);
+    propagateHead = trail.size();
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  SatSolver
+ *      Method:  SatSolver :: Solve
+ * Description:  Returns SAT_SATISFIABLE, SAT_UNSATISFIABLE or SAT_UNKNOWN.
+ *
+ *               The clock is read once every 64 conflicts, starting with the first
+ *               call, so a solve that starts after stopTime ends at once.
+ *--------------------------------------------------------------------------------------
+ */
+int SatSolver::Solve () {
+
+    vector <int> learntClause;
+    unsigned long numberConflicts = 0;
+    unsigned long numberRestarts = 0;
+    unsigned long nextRestart = SAT_RESTART_BASE * lubySequence(0);
+
+    if (isUnsatisfiable || Propagate() >= 0)
+        return SAT_UNSATISFIABLE;
+    if (chrono::steady_clock::now() >= stopTime)
+        return SAT_UNKNOWN;
+
+    while (true) {
+        int conflictClause = Propagate();
+
+        if (conflictClause >= 0) {
+            numberConflicts++;
+            totalConflicts++;
+            if (levelStart.empty())
+                return SAT_UNSATISFIABLE;
+
+            int backtrackLevel;
+            Analyze(conflictClause, learntClause, backtrackLevel);
+            Backtrack(backtrackLevel);
+            if (learntClause.size() == 1)
+                Assign(learntClause[0], -1);
+            else
+                Assign(learntClause[0], AttachClause(learntClause));
+            activityIncrement /= SAT_ACTIVITY_DECAY;
+
+            if (conflictLimit > 0 && numberConflicts >= conflictLimit)
+                return SAT_UNKNOWN;
+            if ((numberConflicts & 63) == 0 && chrono::steady_clock::now() >= stopTime)
+                return SAT_UNKNOWN;
+            continue;
+        }
+
+        if (numberConflicts >= nextRestart) {
+            numberRestarts++;
+            nextRestart = numberConflicts + SAT_RESTART_BASE * lubySequence(numberRestarts);
+            Backtrack(0);
+        }
+
+        int nextVariable = -1;
+        while (!heap.empty()) {
+            nextVariable = HeapPop();
+            if (assignment[nextVariable] < 0)
+                break;
+            nextVariable = -1;
+        }
+        if (nextVariable < 0)
+            return SAT_SATISFIABLE;
+
+        totalDecisions++;
+        levelStart.push_back(trail.size());
+        Assign(Literal(nextVariable, savedValue[nextVariable] == 0), -1);
+    }
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  SatSolver
+ *      Method:  SatSolver :: BumpActivity
+ * Description:  Raises the priority of a variable that took part in a conflict. The
+ *               increment grows after every conflict, which makes the older bumps
+ *               count less, and all the values are scaled down before they overflow.
+ *--------------------------------------------------------------------------------------
+ */
+void SatSolver::BumpActivity (int inVariable) {
+
+    activity[inVariable] += activityIncrement;
+    if (activity[inVariable] > 1e100) {
+        for (int i = 0; i < activity.size(); i++) {
+            activity[i] *= 1e-100;
+        }
+        activityIncrement *= 1e-100;
+    }
+    if (heapPosition[inVariable] >= 0)
+        HeapUp(heapPosition[inVariable]);
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  SatSolver
+ *      Method:  SatSolver :: HeapInsert
+ * Description:  Adds a variable to the decision heap.
+ *--------------------------------------------------------------------------------------
+ */
+void SatSolver::HeapInsert (int inVariable) {
+
+    heapPosition[inVariable] = heap.size();
+    heap.push_back(inVariable);
+    HeapUp(heap.size() - 1);
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  SatSolver
+ *      Method:  SatSolver :: HeapUp
+ * Description:  Moves the variable at the given position up while its activity is
+ *               higher than its parent's.
+ *--------------------------------------------------------------------------------------
+ */
+void SatSolver::HeapUp (int inPosition) {
+
+    int thisVariable = heap[inPosition];
+    while (inPosition > 0) {
+        int parent = (inPosition - 1) >> 1;
+        if (activity[heap[parent]] >= activity[thisVariable])
+            break;
+        heap[inPosition] = heap[parent];
+        heapPosition[heap[inPosition]] = inPosition;
+        inPosition = parent;
+    }
+    heap[inPosition] = thisVariable;
+    heapPosition[thisVariable] = inPosition;
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  SatSolver
+ *      Method:  SatSolver :: HeapDown
+ * Description:  Moves the variable at the given position down while a child has a
+ *               higher activity.
+ *--------------------------------------------------------------------------------------
+ */
+void SatSolver::HeapDown (int inPosition) {
+
+    int thisVariable = heap[inPosition];
+    while (2 * inPosition + 1 < heap.size()) {
+        int child = 2 * inPosition + 1;
+        if (child + 1 < heap.size() && activity[heap[child + 1]] > activity[heap[child]])
+            child++;
+        if (activity[heap[child]] <= activity[thisVariable])
+            break;
+        heap[inPosition] = heap[child];
+        heapPosition[heap[inPosition]] = inPosition;
+        inPosition = child;
+    }
+    heap[inPosition] = thisVariable;
+    heapPosition[thisVariable] = inPosition;
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  SatSolver
+ *      Method:  SatSolver :: HeapPop
+ * Description:  Removes and returns the variable with the highest activity. The heap
+ *               must not be empty.
+ *--------------------------------------------------------------------------------------
+ */
+int SatSolver::HeapPop () {
+
+    int topVariable = heap[0];
+    heapPosition[topVariable] = -1;
+    heap[0] = heap.back();
+    heap.pop_back();
+    if (!heap.empty()) {
+        heapPosition[heap[0]] = 0;
+        HeapDown(0);
+    }
+    return topVariable;
+}
+
+} /* namespace nameSpace_ATPG */
@@ -0,0 +1,164 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  SatSolver.h
+ *
+ *    Description:  The SatSolver class. This class decides if a formula in conjunctive
+ *                  normal form (a list of clauses) can be satisfied.
+ *
+ *                  It is a conflict driven clause learning (CDCL) solver. Every
+ *                  decision is followed by unit propagation with two watched literals
+ *                  per clause. A conflict is analysed back to its first unique
+ *                  implication point, the learnt clause is added, and the search jumps
+ *                  back to the level where that clause becomes unit. Decisions are
+ *                  picked by activity (VSIDS) with the last value of the variable, and
+ *                  the search restarts on the Luby sequence.
+ *
+ *        Version:  1.0
+ *        Created:  12/02/2011
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  Aditya Shevade <aditya.shevade@gmail.com>,
+ *                  Amey Marathe <marathe.amey@gmail.com>,
+ *                  Samik Biswas <samiksb@gmail.com>,
+ *                  Viraj Bhogle <viraj.bhogle@gmail.com>
+ *
+ * =====================================================================================
+ */
+
+#ifndef SATSOLVER_H_
+#define SATSOLVER_H_
+
+namespace nameSpace_ATPG {
+
+/*
+ * Return values of Solve.
+ */
+#define SAT_UNKNOWN         -1  // A limit was hit first.
+#define SAT_UNSATISFIABLE   0
+#define SAT_SATISFIABLE     1
+
+
+/*
+ * =====================================================================================
+ *        Class:  SatSolver
+ *  Description:  Variables are numbered from 0 in the order NewVariable returns them.
+ *                A literal is 2 * variable for the variable and 2 * variable + 1 for
+ *                its negation, see Literal.
+ *
+ *                All the clauses are added before Solve is called, and Solve is only
+ *                called once. Learnt clauses are never deleted, so one object is meant
+ *                for one small problem.
+ *
+ *                The limits are a number of conflicts, 0 for no limit, and stopTime.
+ * =====================================================================================
+ */
+class SatSolver {
+    public:
+        unsigned    long    totalDecisions;
+        unsigned    long    totalConflicts;
+
+        unsigned    long    conflictLimit;      // Conflicts before Solve gives up, 0 for no limit.
+        chrono::steady_clock::time_point stopTime;  // Solve gives up after this.
+
+        /*
+         *--------------------------------------------------------------------------------------
+         *       Class:  SatSolver
+         *      Method:  SatSolver :: SatSolver
+         * Description:  Creates an empty formula, with no variables.
+         *--------------------------------------------------------------------------------------
+         */
+        SatSolver ();
+
+        /*
+         *--------------------------------------------------------------------------------------
+         *       Class:  SatSolver
+         *      Method:  SatSolver :: NewVariable
+         * Description:  Adds a variable and returns its number.
+         *--------------------------------------------------------------------------------------
+         */
+        int NewVariable ();
+
+        /*
+         *--------------------------------------------------------------------------------------
+         *       Class:  SatSolver
+         *      Method:  SatSolver :: Literal
+         * Description:  Returns the literal of the variable, or of its negation if
+         *               inIsNegated is true.
+         *--------------------------------------------------------------------------------------
+         */
+        static int Literal (int inVariable, bool inIsNegated) {
+            return 2 * inVariable + (inIsNegated ? 1 : 0);
+        }
+
+        /*
+         *--------------------------------------------------------------------------------------
+         *       Class:  SatSolver
+         *      Method:  SatSolver :: AddClause
+         * Description:  Adds the clause with the given literals. An empty clause makes the
+         *               formula unsatisfiable.
+         *--------------------------------------------------------------------------------------
+         */
+        void AddClause (vector <int> &inLiterals);
+
+        /*
+         *--------------------------------------------------------------------------------------
+         *       Class:  SatSolver
+         *      Method:  SatSolver :: Solve
+         * Description:  Returns SAT_SATISFIABLE, SAT_UNSATISFIABLE or SAT_UNKNOWN. After
+         *               SAT_SATISFIABLE, ModelValue gives the value of every variable.
+         *--------------------------------------------------------------------------------------
+         */
+        int Solve ();
+
+        /*
+         *--------------------------------------------------------------------------------------
+         *       Class:  SatSolver
+         *      Method:  SatSolver :: ModelValue
+         * Description:  Returns the value of the variable in the satisfying assignment.
+         *--------------------------------------------------------------------------------------
+         */
+        bool ModelValue (int inVariable) {
+            return assignment[inVariable] == 1;
+        }
+
+    private:
+        // Clause i is clauseLiterals[clauseStart[i]] up to clauseStart[i] + clauseSize[i].
+        // The first two literals are the watched ones.
+        vector <int>                clauseLiterals;
+        vector <int>                clauseStart;
+        vector <int>                clauseSize;
+        vector < vector <int> >     watchList;      // Clauses watching each literal.
+        bool                        isUnsatisfiable;// An empty clause was found.
+
+        vector <signed char>        assignment;     // Value of each variable, -1 if none.
+        vector <int>                decisionLevel;  // Level each variable was assigned at.
+        vector <int>                reasonClause;   // Clause that implied it, -1 for decisions.
+        vector <signed char>        savedValue;     // Last value of each variable.
+        vector <char>               isSeen;         // Marks for the conflict analysis.
+
+        vector <int>                trail;          // Assigned literals, in order.
+        vector <int>                levelStart;     // Start of each decision level in trail.
+        int                         propagateHead;  // Next literal of trail to propagate.
+
+        vector <double>             activity;       // Decision priority of each variable.
+        double                      activityIncrement;
+        vector <int>                heap;           // Variables, highest activity first.
+        vector <int>                heapPosition;   // Position in heap, -1 if not there.
+
+        int     LiteralValue (int inLiteral);
+        void    Assign (int inLiteral, int inReason);
+        int     Propagate ();
+        void    Analyze (int inConflict, vector <int> &outLearnt, int &outLevel);
+        void    Backtrack (int inLevel);
+        int     AttachClause (vector <int> &inLiterals);
+        void    BumpActivity (int inVariable);
+        void    HeapInsert (int inVariable);
+        void    HeapUp (int inPosition);
+        void    HeapDown (int inPosition);
+        int     HeapPop ();
+};
+
+} /* namespace nameSpace_ATPG */
+#endif /* SATSOLVER_H_ */
@@ -0,0 +1,212 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  StaticLearning.cc
+ *
+ *    Description:  This file defines the methods in the StaticLearning class.
+ *                  The class learns indirect implications between line values and
+ *                  saves them for later runs on the same circuit.
+ *
+ *        Version:  1.0
+ *        Created:  12/02/2011
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  Aditya Shevade <aditya.shevade@gmail.com>,
+ *                  Amey Marathe <marathe.amey@gmail.com>,
+ *                  Samik Biswas <samiksb@gmail.com>,
+ *                  Viraj Bhogle <viraj.bhogle@gmail.com>
+ *
+ * =====================================================================================
+ */
+
+#include "StaticLearning.h"
+#include "ImplicationEngine.h"
+
+// Global constants are defined in this file.
+
+#ifndef GLOBAL_DEFINES_H_
+#include "../include/global_defines.h"
+#endif
+
+namespace nameSpace_ATPG {
+
+/*
+ * First line of a learning file.
+ */
+#define LEARNING_FILE_HEADER "ATPG static learning 1"
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  StaticLearning
+ *      Method:  StaticLearning :: StaticLearning
+ * Description:  Takes in the node list of the circuit and its graph. Nothing is
+ *               learnt until Learn or Load is called.
+ *--------------------------------------------------------------------------------------
+ */
+StaticLearning::StaticLearning (vector <CircuitNode> &inNodeList, CircuitGraph &inGraph) : nodeList (inNodeList), graph (inGraph) {
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  StaticLearning
+ *      Method:  StaticLearning :: BuildLists
+ * Description:  Fills literalStart and impliedLiterals from a list of (from, to)
+ *               literal pairs. Repeated pairs are kept once.
+ *--------------------------------------------------------------------------------------
+ */
+void StaticLearning::BuildLists (vector < pair <int, int> > &inImplications) {
+
+    sort (inImplications.begin(), inImplications.end());
+    inImplications.erase(unique(inImplications.begin(), inImplications.end()), inImplications.end());
+
+    literalStart.assign(2 * nodeList.size() + 1, 0);
+    impliedLiterals.resize(inImplications.size());
+    for (int i = 0; i < inImplications.size(); i++) {
+        literalStart[inImplications[i].first + 1]++;
+        impliedLiterals[i] = inImplications[i].second;
+    }
+    for (int i = 0; i < 2 * nodeList.size(); i++) {
+        literalStart[i + 1] += literalStart[i];
+    }
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  StaticLearning
+ *      Method:  StaticLearning :: Learn
+ * Description:  Implies both values of every line and learns from the results.
+ *
+ *               A line b that gets the value w is a candidate when w is the value
+ *               the gate b only has with all its inputs at the non controlling value
+ *               (1 for AND, 0 for OR, 0 for NAND, 1 for NOR), and b has more than one
+ *               input. Then b = !w does not imply anything about the inputs, so the
+ *               contrapositive is kept.
+ *--------------------------------------------------------------------------------------
+ */
+void StaticLearning::Learn () {
+
+    ImplicationEngine implicationEngine (nodeList, graph);
+    vector < pair <int, int> > implications;
+
+    isImpossible.assign(2 * nodeList.size(), 0);
+
+    for (int thisNode = 0; thisNode < nodeList.size(); thisNode++) {
+        for (int thisValue = ZERO; thisValue <= ONE; thisValue++) {
+            if (!implicationEngine.Imply(thisNode, thisValue)) {
+                isImpossible[Literal(thisNode, thisValue)] = 1;
+                continue;
+            }
+
+            for (int k = 1; k < implicationEngine.impliedNodes.size(); k++) {
+                int impliedNode = implicationEngine.impliedNodes[k];
+                int impliedValue = implicationEngine.Value(impliedNode);
+                unsigned int gateType = nodeList[impliedNode].gateType;
+
+                if (graph.fanInStart[impliedNode + 1] - graph.fanInStart[impliedNode] < 2)
+                    continue;
+                if ((impliedValue == ONE && (gateType == AND || gateType == NOR)) ||
+                    (impliedValue == ZERO && (gateType == OR || gateType == NAND)))
+                    implications.push_back(make_pair(Literal(impliedNode, 1 - impliedValue), Literal(thisNode, 1 - thisValue)));
+            }
+        }
+    }
+
+    BuildLists(implications);
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  StaticLearning
+ *      Method:  StaticLearning :: Save
+ * Description:  Writes the results to the file, with the hash of the circuit file.
+ *               Returns false if the file could not be written.
+ *
+ *               The first line is LEARNING_FILE_HEADER and the second has the hash,
+ *               the number of nodes, of impossible values and of implications. Then
+ *               there is one line per impossible value, with the line number and the
+ *               value, and one per implication, with the line number and value it
+ *               goes from and then the ones it goes to.
+ *--------------------------------------------------------------------------------------
+ */
+bool StaticLearning::Save (char *inFileName, uint64_t inCircuitHash) {
+
+    ofstream outFile (inFileName, ofstream::out);
+    if (!outFile)
+        return false;
+
+    outFile << LEARNING_FILE_HEADER << endl;
+    outFile << inCircuitHash << " " << nodeList.size() << " " << NumberImpossible() << " " << NumberImplications() << endl;
+
+    for (int i = 0; i < isImpossible.size(); i++) {
+        if (isImpossible[i])
+            outFile << nodeList[i >> 1].lineNumber << " " << (i & 1) << endl;
+    }
+    for (int i = 0; i < 2 * nodeList.size(); i++) {
+        for (int k = literalStart[i]; k < literalStart[i + 1]; k++) {
+            outFile << nodeList[i >> 1].lineNumber << " " << (i & 1) << " "
+                    << nodeList[impliedLiterals[k] >> 1].lineNumber << " " << (impliedLiterals[k] & 1) << endl;
+        }
+    }
+
+    outFile.close();
+    return !outFile.fail();
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  StaticLearning
+ *      Method:  StaticLearning :: Load
+ * Description:  Reads the results from the file. Returns false, and learns nothing,
+ *               if the file does not exist, is not a learning file, or was written
+ *               for a circuit with another hash.
+ *--------------------------------------------------------------------------------------
+ */
+bool StaticLearning::Load (char *inFileName, uint64_t inCircuitHash) {
+
+    ifstream inFile (inFileName, ifstream::in);
+    if (!inFile)
+        return false;
+
+    string header;
+    uint64_t fileHash;
+    unsigned long numberNodes;
+    int numberImpossible, numberImplications;
+
+    getline(inFile, header);
+    if (header != LEARNING_FILE_HEADER)
+        return false;
+    if (!(inFile >> fileHash >> numberNodes >> numberImpossible >> numberImplications))
+        return false;
+    if (fileHash != inCircuitHash || numberNodes != nodeList.size())
+        return false;
+
+    vector <char> fileImpossible (2 * nodeList.size(), 0);
+    vector < pair <int, int> > implications;
+    int fromLine, fromValue, toLine, toValue;
+
+    for (int i = 0; i < numberImpossible; i++) {
+        if (!(inFile >> fromLine >> fromValue))
+            return false;
+        int fromNode = graph.FindNode(fromLine);
+        if (fromNode < 0 || (fromValue != ZERO && fromValue != ONE))
+            return false;
+        fileImpossible[Literal(fromNode, fromValue)] = 1;
+    }
+    for (int i = 0; i < numberImplications; i++) {
+        if (!(inFile >> fromLine >> fromValue >> toLine >> toValue))
+            return false;
+        int fromNode = graph.FindNode(fromLine);
+        int toNode = graph.FindNode(toLine);
+        if (fromNode < 0 || toNode < 0 || (fromValue != ZERO && fromValue != ONE) || (toValue != ZERO && toValue != ONE))
+            return false;
+        implications.push_back(make_pair(Literal(fromNode, fromValue), Literal(toNode, toValue)));
+    }
+
+    isImpossible.swap(fileImpossible);
+    BuildLists(implications);
+
+    return true;
+}
+
+} /* namespace nameSpace_ATPG */
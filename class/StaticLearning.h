@@ -0,0 +1,137 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  StaticLearning.h
+ *
+ *    Description:  The StaticLearning class. This class learns the implications
+ *                  between line values that are only found through reconvergent fan
+ *                  out, as in SOCRATES, once for the circuit.
+ *
+ *                  If a = v implies b = w, then b = !w implies a = !v. When b = w
+ *                  needs all the inputs of the gate b, the second implication can not
+ *                  be found by implying b = !w directly, so it is learnt. If a = v
+ *                  implies a conflict, a can never be v.
+ *
+ *        Version:  1.0
+ *        Created:  12/02/2011
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  Aditya Shevade <aditya.shevade@gmail.com>,
+ *                  Amey Marathe <marathe.amey@gmail.com>,
+ *                  Samik Biswas <samiksb@gmail.com>,
+ *                  Viraj Bhogle <viraj.bhogle@gmail.com>
+ *
+ * =====================================================================================
+ */
+
+#ifndef STATICLEARNING_H_
+#define STATICLEARNING_H_
+
+namespace nameSpace_ATPG {
+
+
+/*
+ * =====================================================================================
+ *        Class:  StaticLearning
+ *  Description:  A literal is a node and a value, 2 * node + value, see Literal.
+ *
+ *                The implications learnt from literal i are the literals
+ *                impliedLiterals[literalStart[i]] up to (but not including)
+ *                impliedLiterals[literalStart[i + 1]]. isImpossible is set for the
+ *                literals that can never be true.
+ *
+ *                The results can be saved to a file and loaded in a later run. The
+ *                file holds a hash of the circuit file it was learnt for and the
+ *                lines by line number, and is not loaded for any other circuit.
+ * =====================================================================================
+ */
+class StaticLearning {
+    public:
+        vector <int>        literalStart;       // Start of the implications of each literal.
+        vector <int>        impliedLiterals;    // Implications of all the literals.
+        vector <char>       isImpossible;       // True for a literal that can never hold.
+
+        /*
+         *--------------------------------------------------------------------------------------
+         *       Class:  StaticLearning
+         *      Method:  StaticLearning :: StaticLearning
+         * Description:  Takes in the node list of the circuit and its graph. Nothing is
+         *               learnt until Learn or Load is called.
+         *--------------------------------------------------------------------------------------
+         */
+        StaticLearning (vector <CircuitNode> &inNodeList, CircuitGraph &inGraph);
+
+        /*
+         *--------------------------------------------------------------------------------------
+         *       Class:  StaticLearning
+         *      Method:  StaticLearning :: Literal
+         * Description:  Returns the literal of the node with the value (ZERO or ONE).
+         *--------------------------------------------------------------------------------------
+         */
+        static int Literal (int inNode, int inValue) {
+            return 2 * inNode + inValue;
+        }
+
+        /*
+         *--------------------------------------------------------------------------------------
+         *       Class:  StaticLearning
+         *      Method:  StaticLearning :: Learn
+         * Description:  Implies both values of every line and learns from the results.
+         *               The circuit must already be levelized.
+         *--------------------------------------------------------------------------------------
+         */
+        void Learn ();
+
+        /*
+         *--------------------------------------------------------------------------------------
+         *       Class:  StaticLearning
+         *      Method:  StaticLearning :: Save
+         * Description:  Writes the results to the file, with the hash of the circuit
+         *               file. Returns false if the file could not be written.
+         *--------------------------------------------------------------------------------------
+         */
+        bool Save (char *inFileName, uint64_t inCircuitHash);
+
+        /*
+         *--------------------------------------------------------------------------------------
+         *       Class:  StaticLearning
+         *      Method:  StaticLearning :: Load
+         * Description:  Reads the results from the file. Returns false, and learns
+         *               nothing, if the file does not exist, is not a learning file, or
+         *               was written for a circuit with another hash.
+         *--------------------------------------------------------------------------------------
+         */
+        bool Load (char *inFileName, uint64_t inCircuitHash);
+
+        /*
+         *--------------------------------------------------------------------------------------
+         *       Class:  StaticLearning
+         *      Method:  StaticLearning :: NumberImplications
+         * Description:  Returns the number of learnt implications.
+         *--------------------------------------------------------------------------------------
+         */
+        int NumberImplications () {
+            return impliedLiterals.size();
+        }
+
+        /*
+         *--------------------------------------------------------------------------------------
+         *       Class:  StaticLearning
+         *      Method:  StaticLearning :: NumberImpossible
+         * Description:  Returns the number of literals that can never hold.
+         *--------------------------------------------------------------------------------------
+         */
+        int NumberImpossible () {
+            return count(isImpossible.begin(), isImpossible.end(), 1);
+        }
+
+    private:
+        vector <CircuitNode>        &nodeList;      // The circuit, read only.
+        CircuitGraph                &graph;         // Fan in and fan out of the nodes, read only.
+
+        void    BuildLists (vector < pair <int, int> > &inImplications);
+};
+
+} /* namespace nameSpace_ATPG */
+#endif /* STATICLEARNING_H_ */
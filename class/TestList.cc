@@ -41,6 +41,7 @@ TestList::TestList (int inLineNumber, bool inStuckAtValue, string inTestVector)
     this->stuckAtValue = inStuckAtValue;
     this->testVector = inTestVector;
     this->isTestPossible = true;
+    this->isAborted = false;
 }
 
 /*
@@ -49,7 +50,9 @@ TestList::TestList (int inLineNumber, bool inStuckAtValue, string inTestVector)
  *      Method:  TestList :: TestList
  * Description:  There can be cases where no test vector can detect the fault at the
  *               given line. In that case, only the line number and fault pair is sent
- *               to the constructor and the test possible flag is set to false.
+ *               to the constructor and the test possible flag is set to false. The
+ *               fault is taken as redundant, isAborted has to be set afterwards for
+ *               an aborted fault.
  *--------------------------------------------------------------------------------------
  */
 TestList::TestList (int inLineNumber, bool inStuckAtValue) {
@@ -57,6 +60,7 @@ TestList::TestList (int inLineNumber, bool inStuckAtValue) {
     this->stuckAtValue = inStuckAtValue;
     this->testVector = "";
     this->isTestPossible = false;
+    this->isAborted = false;
 }
 
 } /* namespace nameSpace_ATPG */
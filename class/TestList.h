@@ -33,6 +33,10 @@ namespace nameSpace_ATPG {
  *        Class:  TestList
  *  Description:  This class stores the information about the line number, the fault
  *                value, the test vector and a flag that is set if test is possible.
+ *
+ *                A fault without a test is either proven redundant or aborted, when
+ *                the search hit its limits first. The isAborted flag is set for the
+ *                aborted ones.
  * =====================================================================================
  */
 class TestList {
@@ -40,6 +44,7 @@ class TestList {
         unsigned    int     lineNumber;
                     bool    stuckAtValue;
                     bool    isTestPossible;
+                    bool    isAborted;
                     string  testVector;
 
         /*
@@ -59,7 +64,9 @@ class TestList {
          *      Method:  TestList :: TestList
          * Description:  There can be cases where no test vector can detect the fault at the
          *               given line. In that case, only the line number and fault pair is sent
-         *               to the constructor and the test possible flag is set to false.
+         *               to the constructor and the test possible flag is set to false. The
+         *               fault is taken as redundant, isAborted has to be set afterwards
+         *               for an aborted fault.
          *--------------------------------------------------------------------------------------
          */
         TestList (int inLineNumber, bool inStuckAtValue);
@@ -0,0 +1,125 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  VectorEnumerator.cc
+ *
+ *    Description:  This file defines the methods in the VectorEnumerator class.
+ *                  The class produces the input vectors for the exhaustive search
+ *                  one at a time.
+ *
+ *        Version:  1.0
+ *        Created:  12/02/2011
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  Aditya Shevade <aditya.shevade@gmail.com>,
+ *                  Amey Marathe <marathe.amey@gmail.com>,
+ *                  Samik Biswas <samiksb@gmail.com>,
+ *                  Viraj Bhogle <viraj.bhogle@gmail.com>
+ *
+ * =====================================================================================
+ */
+
+#include "VectorEnumerator.h"
+
+// Global constants are defined in this file.
+
+#ifndef GLOBAL_DEFINES_H_
+#include "../include/global_defines.h"
+#endif
+
+namespace nameSpace_ATPG {
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  VectorEnumerator
+ *      Method:  VectorEnumerator :: VectorEnumerator
+ * Description:  Takes in the number of primary inputs. The first vector is the one
+ *               with X on all the inputs but the last, which is 1.
+ *--------------------------------------------------------------------------------------
+ */
+VectorEnumerator::VectorEnumerator (int inTotalInputs) {
+
+    currentVector.assign(inTotalInputs, '0' + X);
+    numberOfX = inTotalInputs - 1;
+    isDone = (inTotalInputs == 0);
+    if (!isDone)
+        FirstVector();
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  VectorEnumerator
+ *      Method:  VectorEnumerator :: FirstVector
+ * Description:  Sets the current vector to the largest one with numberOfX X, which
+ *               has all the X first and 1 everywhere else.
+ *--------------------------------------------------------------------------------------
+ */
+void VectorEnumerator::FirstVector () {
+
+    for (int i = 0; i < currentVector.length(); i++) {
+        currentVector[i] = (i < numberOfX ? '0' + X : '1');
+    }
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  VectorEnumerator
+ *      Method:  VectorEnumerator :: StepVector
+ * Description:  Moves to the next smaller vector with the same number of X, or to the
+ *               first vector with one X less when there is none.
+ *
+ *               The last position that can be lowered (X to 1, or 1 to 0) while
+ *               still leaving room for the remaining X after it is lowered by one
+ *               step. Everything after it is then set to the largest fill, the
+ *               remaining X first and then 1.
+ *--------------------------------------------------------------------------------------
+ */
+void VectorEnumerator::StepVector () {
+
+    int totalInputs = currentVector.length();
+    int suffixX = 0;                                // X from position i to the end.
+
+    for (int i = totalInputs - 1; i >= 0; i--) {
+        if (currentVector[i] == '0' + X)
+            suffixX++;
+        if (currentVector[i] == '0')
+            continue;
+
+        // X that have to go after position i once it is no longer X.
+        int remainingX = suffixX;
+        if (remainingX > (totalInputs - i - 1))
+            continue;
+
+        currentVector[i] = (currentVector[i] == '1' ? '0' : '1');
+        for (int j = i + 1; j < totalInputs; j++) {
+            currentVector[j] = ((j - i) <= remainingX ? '0' + X : '1');
+        }
+        return;
+    }
+
+    if (--numberOfX < 0)
+        isDone = true;
+    else
+        FirstVector();
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  VectorEnumerator
+ *      Method:  VectorEnumerator :: NextVector
+ * Description:  Writes the next vector to outVector, one character per primary
+ *               input, with 4 for X. Returns false once all the vectors are done.
+ *--------------------------------------------------------------------------------------
+ */
+bool VectorEnumerator::NextVector (string &outVector) {
+
+    if (isDone)
+        return false;
+
+    outVector = currentVector;
+    StepVector();
+    return true;
+}
+
+} /* namespace nameSpace_ATPG */
@@ -0,0 +1,74 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  VectorEnumerator.h
+ *
+ *    Description:  The VectorEnumerator class. This class produces the input vectors
+ *                  for the exhaustive search one at a time, so the list of all the
+ *                  3^n vectors is never stored.
+ *
+ *                  The vectors come in the same order the exhaustive search always
+ *                  used. The vectors with the most X come first, and the vectors with
+ *                  the same number of X come in decreasing order when read as base 3
+ *                  numbers with X as the digit 2. The vector with all X is skipped.
+ *
+ *        Version:  1.0
+ *        Created:  12/02/2011
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  Aditya Shevade <aditya.shevade@gmail.com>,
+ *                  Amey Marathe <marathe.amey@gmail.com>,
+ *                  Samik Biswas <samiksb@gmail.com>,
+ *                  Viraj Bhogle <viraj.bhogle@gmail.com>
+ *
+ * =====================================================================================
+ */
+
+#ifndef VECTORENUMERATOR_H_
+#define VECTORENUMERATOR_H_
+
+namespace nameSpace_ATPG {
+
+
+/*
+ * =====================================================================================
+ *        Class:  VectorEnumerator
+ *  Description:  Only the current vector and its number of X are kept. The next vector
+ *                is found from the current one in time linear in the number of inputs.
+ * =====================================================================================
+ */
+class VectorEnumerator {
+    public:
+
+        /*
+         *--------------------------------------------------------------------------------------
+         *       Class:  VectorEnumerator
+         *      Method:  VectorEnumerator :: VectorEnumerator
+         * Description:  Takes in the number of primary inputs. The first vector is the one
+         *               with X on all the inputs but the last, which is 1.
+         *--------------------------------------------------------------------------------------
+         */
+        VectorEnumerator (int inTotalInputs);
+
+        /*
+         *--------------------------------------------------------------------------------------
+         *       Class:  VectorEnumerator
+         *      Method:  VectorEnumerator :: NextVector
+         * Description:  Writes the next vector to outVector, one character per primary
+         *               input, with 4 for X. Returns false once all the vectors are done.
+         *--------------------------------------------------------------------------------------
+         */
+        bool NextVector (string &outVector);
+
+    private:
+        string      currentVector;      // Vector returned by the next call.
+        int         numberOfX;          // Number of X in currentVector.
+        bool        isDone;             // True once the last vector was returned.
+
+        void        FirstVector ();
+        void        StepVector ();
+};
+
+} /* namespace nameSpace_ATPG */
+#endif /* VECTORENUMERATOR_H_ */
@@ -0,0 +1,96 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  WorkQueue.cc
+ *
+ *    Description:  This file defines the methods in the WorkQueue class.
+ *                  The class hands out work items to worker threads.
+ *
+ *        Version:  1.0
+ *        Created:  12/02/2011
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  Aditya Shevade <aditya.shevade@gmail.com>,
+ *                  Amey Marathe <marathe.amey@gmail.com>,
+ *                  Samik Biswas <samiksb@gmail.com>,
+ *                  Viraj Bhogle <viraj.bhogle@gmail.com>
+ *
+ * =====================================================================================
+ */
+
+#include "WorkQueue.h"
+
+// Global constants are defined in this file.
+
+#ifndef GLOBAL_DEFINES_H_
+#include "../include/global_defines.h"
+#endif
+
+namespace nameSpace_ATPG {
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  WorkQueue
+ *      Method:  WorkQueue :: WorkQueue
+ * Description:  Splits the items 0 to inNumberItems - 1 between inNumberWorkers
+ *               queues.
+ *--------------------------------------------------------------------------------------
+ */
+WorkQueue::WorkQueue (int inNumberItems, int inNumberWorkers) : workerItems (inNumberWorkers), workerLock (inNumberWorkers) {
+
+    for (int w = 0; w < inNumberWorkers; w++) {
+        int firstItem = (long) inNumberItems * w / inNumberWorkers;
+        int lastItem = (long) inNumberItems * (w + 1) / inNumberWorkers;
+        for (int i = firstItem; i < lastItem; i++)
+            workerItems[w].push_back(i);
+    }
+}
+
+/*
+ *--------------------------------------------------------------------------------------
+ *       Class:  WorkQueue
+ *      Method:  WorkQueue :: NextItem
+ * Description:  Gives the next item for the worker in outItem. Returns false when
+ *               there are no items left in any queue.
+ *
+ *               The worker first looks at its own queue. If it is empty, the other
+ *               queues are tried in turn and half of the first non empty one is
+ *               moved over. Only one lock is held at a time.
+ *--------------------------------------------------------------------------------------
+ */
+bool WorkQueue::NextItem (int inWorker, int &outItem) {
+
+    int numberWorkers = workerItems.size();
+
+    while (true) {
+        {
+            lock_guard <mutex> ownLock (workerLock[inWorker]);
+            if (!workerItems[inWorker].empty()) {
+                outItem = workerItems[inWorker].front();
+                workerItems[inWorker].pop_front();
+                return true;
+            }
+        }
+
+        vector <int> stolenItems;
+        for (int k = 1; k < numberWorkers && stolenItems.empty(); k++) {
+            int victim = (inWorker + k) % numberWorkers;
+            lock_guard <mutex> victimLock (workerLock[victim]);
+            int numberStolen = (workerItems[victim].size() + 1) / 2;
+            for (int i = 0; i < numberStolen; i++) {
+                stolenItems.push_back(workerItems[victim].back());
+                workerItems[victim].pop_back();
+            }
+        }
+        if (stolenItems.empty())
+            return false;
+
+        // The items were taken from the back, put them back in order.
+        lock_guard <mutex> ownLock (workerLock[inWorker]);
+        for (int i = 0; i < stolenItems.size(); i++)
+            workerItems[inWorker].push_front(stolenItems[i]);
+    }
+}
+
+} /* namespace nameSpace_ATPG */
@@ -0,0 +1,69 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  WorkQueue.h
+ *
+ *    Description:  The WorkQueue class. This class hands out work items (numbers
+ *                  0 to N - 1) to a fixed number of worker threads.
+ *
+ *                  Every worker has its own queue of items and takes them from the
+ *                  front. A worker whose queue is empty steals half of the items
+ *                  from the back of another queue, so the work stays balanced even
+ *                  when some items take much longer than others.
+ *
+ *        Version:  1.0
+ *        Created:  12/02/2011
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  Aditya Shevade <aditya.shevade@gmail.com>,
+ *                  Amey Marathe <marathe.amey@gmail.com>,
+ *                  Samik Biswas <samiksb@gmail.com>,
+ *                  Viraj Bhogle <viraj.bhogle@gmail.com>
+ *
+ * =====================================================================================
+ */
+
+#ifndef WORKQUEUE_H_
+#define WORKQUEUE_H_
+
+namespace nameSpace_ATPG {
+
+
+/*
+ * =====================================================================================
+ *        Class:  WorkQueue
+ *  Description:  At the start, worker W gets the W-th equal part of the items, in
+ *                order. With one worker the items come out in order 0 to N - 1.
+ * =====================================================================================
+ */
+class WorkQueue {
+    public:
+
+        /*
+         *--------------------------------------------------------------------------------------
+         *       Class:  WorkQueue
+         *      Method:  WorkQueue :: WorkQueue
+         * Description:  Splits the items 0 to inNumberItems - 1 between inNumberWorkers
+         *               queues.
+         *--------------------------------------------------------------------------------------
+         */
+        WorkQueue (int inNumberItems, int inNumberWorkers);
+
+        /*
+         *--------------------------------------------------------------------------------------
+         *       Class:  WorkQueue
+         *      Method:  WorkQueue :: NextItem
+         * Description:  Gives the next item for the worker in outItem. Returns false when
+         *               there are no items left in any queue.
+         *--------------------------------------------------------------------------------------
+         */
+        bool NextItem (int inWorker, int &outItem);
+
+    private:
+        vector < deque <int> >      workerItems;    // Queue of each worker.
+        vector <mutex>              workerLock;     // Lock for each queue.
+};
+
+} /* namespace nameSpace_ATPG */
+#endif /* WORKQUEUE_H_ */
@@ -69,6 +69,16 @@ namespace nameSpace_ATPG {
     #define WRITE cout
 #endif
 
+/*
+ * Widest block of vectors the fault simulator may use, in 64 bit words. With
+ * 8 the simulator uses AVX-512 (512 vectors at a time) or AVX2 (256 vectors)
+ * when the processor has them. Set it to 4 to stop at AVX2, or to 1 to always
+ * use the portable 64 bit version.
+ */
+#ifndef MAX_SIMULATION_WORDS
+#define MAX_SIMULATION_WORDS 8
+#endif
+
 /*
  * These are the node type values.
  */
@@ -89,7 +99,7 @@ namespace nameSpace_ATPG {
 #define G_NOT   5   // NOT Gate.
 #define G_NAND  6   // NAND Gate.
 #define G_AND   7   // AND Gate.
-#define G_XNOR  8   // XNOR Gate. Not implemented in out circuits.
+#define G_XNOR  8   // XNOR Gate.
 
 // Defined below are the 5 possible "binary" logic values.
 // Tables are pretty simple. B is invert of D and X is unknown.
@@ -100,6 +110,22 @@ namespace nameSpace_ATPG {
 #define B       3   // This is Dbar.
 #define X       4
 
+// Packed form of the 5 values, used when gates are evaluated. The fault free
+// and the faulty value are kept as two bit pairs, a 1 bit and a 0 bit each.
+// If neither bit of a pair is set the value is unknown, and a value with any
+// unknown part is X.
+
+#define V_GOOD_ONE      0x1
+#define V_GOOD_ZERO     0x2
+#define V_FAULT_ONE     0x4
+#define V_FAULT_ZERO    0x8
+
+#define V_ZERO  (V_GOOD_ZERO | V_FAULT_ZERO)
+#define V_ONE   (V_GOOD_ONE | V_FAULT_ONE)
+#define V_D     (V_GOOD_ONE | V_FAULT_ZERO)
+#define V_B     (V_GOOD_ZERO | V_FAULT_ONE)
+#define V_X     0
+
 // Gate types. Integer value which would be read from a file.
 
 #define PS_PI   0   // Primary input. Not named PI to avoid conflict.
@@ -110,7 +136,82 @@ namespace nameSpace_ATPG {
 #define INV     5
 #define NAND    6
 #define AND     7
-#define XNOR    8   // Not implemented yet in the circuit file.
+#define XNOR    8
+
+// Largest SCOAP value. The sums stop here, so that the values of very deep
+// circuits do not overflow.
+
+#define SCOAP_LIMIT     100000000
+
+// Line numbers are looked up in a table indexed by the line number while the
+// largest one is less than this many times the number of nodes, and searched in
+// a sorted list otherwise, see CircuitGraph.
+
+#define LINE_TABLE_FACTOR   4
+
+// Order in which the faults are given to the test generation.
+
+#define ORDER_LIST      0   // Fault list order, the default.
+#define ORDER_EASY      1   // Easiest faults first, hardest last.
+#define ORDER_HARD      2   // Hardest faults first.
+
+// Test generation algorithms. Selected from the command line.
+
+#define ATPG_EXHAUSTIVE 0   // Try every input vector, fewest assigned inputs first.
+#define ATPG_PODEM      1   // PODEM search, the default.
+#define ATPG_FAN        2   // PODEM with the FAN headlines and multiple backtrace.
+
+// Random pattern phase, see RandomPatternATPG. The patterns are fault simulated
+// a block at a time, and the phase stops after the first block that detects
+// less than RANDOM_MIN_GAIN percent of the target faults, or after
+// RANDOM_MAX_BLOCKS blocks.
+
+#define RANDOM_BLOCK_VECTORS    512
+#define RANDOM_MAX_BLOCKS       256
+#define RANDOM_MIN_GAIN         0.5
+
+// State of a fault during test generation. Shared between the worker threads.
+
+#define FAULT_PENDING   0   // No worker has looked at the fault yet.
+#define FAULT_SEARCHING 1   // A worker is searching for a test.
+#define FAULT_DETECTED  2   // The search found a test.
+#define FAULT_DROPPED   3   // Detected by the test of another fault.
+#define FAULT_REDUNDANT 4   // The search proved that no test exists.
+#define FAULT_ABORTED   5   // The search hit a limit before it was done.
+
+// Backtracks before the PODEM search for a fault is aborted, unless the -b
+// option gives another limit (-b 0 for none).
+
+#define DEFAULT_BACKTRACK_LIMIT 1000
+
+// Aborted faults are searched again once all the other faults are done, with
+// the backtrack and time limits multiplied by this factor.
+
+#define RETRY_LIMIT_FACTOR  10
+
+/*
+ * Backtrack limit of PODEM when the aborted faults go to the SAT search and the
+ * -b option was not given.
+ */
+#define SAT_PODEM_BACKTRACKS    100
+
+/*
+ * Backtrack limit of every search for a fault that dynamic compaction (-x option)
+ * tries to add to a test.
+ */
+#define COMPACTION_BACKTRACKS   16
+
+/*
+ * Circuit cache files (-k option) start with the magic word and the version. A
+ * cache with another version is not loaded, so the version has to change whenever
+ * CircuitNode, CircuitGraph or FaultClasses change what they hold.
+ */
+#define CIRCUIT_CACHE_MAGIC     0x4548434143475441ULL   // "ATPGCACH"
+#define CIRCUIT_CACHE_VERSION   1
+
+// Starting value of the FNV-1a hashes of files and cache contents, see hashBytes.
+
+#define HASH_START  14695981039346656037ULL
 
 }
 
@@ -97,6 +97,18 @@ int BRNCHTABLE [5]  =   {               0,  1,  D,  B,  X   };
                                     //  0   1   D   B   X
 int ONEXORTABLE [5] =   {               0,  0,  0,  0,  X   };
 
+// Conversion between the 5 values and their packed form (see global_defines.h).
+// The packed values follow the tables above, so the tables are what the packed
+// gate evaluation in forward_implication.cc has to reproduce.
+
+                                            //  0       1       D       B       X
+unsigned char PACKTABLE [5]     =   {           V_ZERO, V_ONE,  V_D,    V_B,    V_X };
+
+                                //  0x0 0x1 0x2 0x3 0x4 0x5 0x6 0x7
+int UNPACKTABLE [16]    =   {       X,  X,  X,  X,  X,  ONE, B, X,
+                                //  0x8 0x9 0xA 0xB 0xC 0xD 0xE 0xF
+                                    X,  D,  ZERO, X, X, X,  X,  X   };
+
 } /* nameSpace_ATPG */
 
 #endif /* LOGIC_TABLES_H_ */
@@ -79,4 +79,86 @@ void openOutFile (char *fileName, ofstream &inFile, ofstream &logFile) {
     }
 }
 
+/*
+ * ===  FUNCTION  ======================================================================
+ *         Name:  mapFile
+ *  Description:  Maps the whole file into memory, read only, and returns its start,
+ *                with the size in outSize. Returns NULL if the file can not be opened
+ *                or mapped. Every mapped file is released with unmapFile.
+ * =====================================================================================
+ */
+const char *mapFile (const char *fileName, size_t &outSize) {
+    static const char emptyFile[1] = { 0 };
+
+    int fileDescriptor = open (fileName, O_RDONLY);
+    if (fileDescriptor < 0)
+        return NULL;
+
+    struct stat fileStatus;
+    if (fstat (fileDescriptor, &fileStatus) != 0) {
+        close (fileDescriptor);
+        return NULL;
+    }
+
+    outSize = fileStatus.st_size;
+    if (outSize == 0) {                     // mmap does not take an empty file.
+        close (fileDescriptor);
+        return emptyFile;
+    }
+
+    void *fileData = mmap (NULL, outSize, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+    close (fileDescriptor);
+    if (fileData == MAP_FAILED)
+        return NULL;
+    madvise (fileData, outSize, MADV_SEQUENTIAL);
+    return (const char *)fileData;
+}
+
+/*
+ * ===  FUNCTION  ======================================================================
+ *         Name:  unmapFile
+ *  Description:  Releases a file mapped by mapFile.
+ * =====================================================================================
+ */
+void unmapFile (const char *fileData, size_t fileSize) {
+    if (fileData != NULL && fileSize > 0)
+        munmap ((void *)fileData, fileSize);
+}
+
+/*
+ * ===  FUNCTION  ======================================================================
+ *         Name:  hashBytes
+ *  Description:  Adds the bytes to a 64 bit FNV-1a hash. The hash of a number of
+ *                blocks is found by starting from HASH_START and passing the result
+ *                of each block to the next.
+ * =====================================================================================
+ */
+uint64_t hashBytes (const char *inData, size_t inSize, uint64_t inHash) {
+    for (size_t i = 0; i < inSize; i++) {
+        inHash = (inHash ^ (unsigned char)inData[i]) * 1099511628211ULL;
+    }
+    return inHash;
+}
+
+/*
+ * ===  FUNCTION  ======================================================================
+ *         Name:  hashFile
+ *  Description:  Returns the 64 bit FNV-1a hash of the contents of the file, so the
+ *                results saved for a circuit file can be matched with it later. The
+ *                program exits if the file can not be read.
+ * =====================================================================================
+ */
+uint64_t hashFile (char *fileName) {
+    size_t fileSize;
+    const char *fileData = mapFile (fileName, fileSize);
+    if (fileData == NULL) {
+        cerr << "ERROR: File could not be opened." << endl;
+        exit (1);
+    }
+
+    uint64_t hash = hashBytes (fileData, fileSize, HASH_START);
+    unmapFile (fileData, fileSize);
+    return hash;
+}
+
 } /* nameSpace_ATPG */
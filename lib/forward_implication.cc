@@ -3,9 +3,9 @@
  *
  *       Filename:  forward_implication.cc
  *
- *    Description:  This function performs forward implication on a 1-3 input gate.
- *                  The inputs and output are integer sets. It reads the values from
- *                  logic tables.
+ *    Description:  These functions perform forward implication on a gate. The gate
+ *                  values are kept in a packed form and evaluated with bit operations
+ *                  that follow the logic tables.
  *
  *        Version:  1.0
  *        Created:  12/02/2011
@@ -39,145 +39,352 @@ using namespace std;
 namespace nameSpace_ATPG {
 
 /*-----------------------------------------------------------------------------
- * The function forwardImplication is overloaded. The gates in the circuits
- * we analyze can have up to 3 inputs. Depending on the number of imputs passed
- * the proper function is executed.
+ * Gates are evaluated on the packed form of the 5 values (see global_defines.h).
+ * The fault free and the faulty values are evaluated together with bit
+ * operations, so there are no table lookups and no branches on the values.
  *
- * Sets are used since we don't want duplicate values at the output. Set will
- * remove duplicate values.
+ * After the gate is evaluated, a value whose fault free or faulty part is
+ * unknown is turned into X. For two inputs the result is the same as the
+ * tables in logic_tables.h. For more inputs the result is never less exact
+ * than applying the tables two inputs at a time.
  *
- * The best way to get the result of any logical operation is to do a table
- * lookup. The tables are defined in the logic_tables.h file included above.
- * The tables can be of any valued logic. We are currently using 5 valued
- * logic in our test generator.
+ * A gate can have any number of inputs. The input values are not copied
+ * anywhere: the caller passes the array with the values of all the lines and
+ * the indices of the gate inputs in it (the fan in list of the CircuitGraph).
+ * Gates with up to 4 inputs, which are most of the gates, get their own copy
+ * of the evaluation with the loops unrolled by the compiler.
  *-----------------------------------------------------------------------------*/
 
+#define ALWAYS_INLINE inline __attribute__((always_inline))
+
 /*
  * ===  FUNCTION  ======================================================================
- *         Name:  forwardImlpication
- *  Description:  The function takes in an STL set as input and returns a set as output.
- *                The version defined below is a single input version.
- *                Set is used since multiple inputs may give same result.
+ *         Name:  packValue
+ *  Description:  Returns the packed form of a value. Packed values are passed through,
+ *                5 values (ZERO, ONE, D, B and X) are looked up.
  * =====================================================================================
  */
-set <int>   forwardImplication (unsigned int gateType, set <int> & input_a) {
-
-    set <int> returnSet;
-    set <int>::iterator i;
-
-    for (i = input_a.begin(); i != input_a.end(); i++) {
-        switch (gateType) {
-            case INV:
-            case NAND:
-            case NOR:
-                returnSet.insert(INVTABLE[*i]);
-                break;
-            case BRNCH:
-            case AND:
-            case OR:
-                returnSet.insert(BRNCHTABLE[*i]);
-                break;
-            case XOR:
-                returnSet.insert(ONEXORTABLE[*i]);
-                break;
-            default:
-                cerr << "Unknown gate type encountered for a gate with only 1 input." << endl;
-                cerr << "Possible values are 0-7. Current value is " << gateType << endl;
-                exit (0);
-                break;
-        }
+ALWAYS_INLINE unsigned int packValue (unsigned char inValue) {
+    return inValue;
+}
+
+ALWAYS_INLINE unsigned int packValue (int inValue) {
+    return PACKTABLE[inValue];
+}
+
+/*
+ * ===  FUNCTION  ======================================================================
+ *         Name:  evaluatePackedInputs
+ *  Description:  Evaluates one gate. The inputs can be packed values or 5 values,
+ *                the result is always packed. When numberInputs is a constant the
+ *                loops are unrolled.
+ * =====================================================================================
+ */
+template <typename ValueType>
+ALWAYS_INLINE unsigned char evaluatePackedInputs (unsigned int gateType, const ValueType *lineValues,
+                                                  const int *inputIndex, unsigned int numberInputs) {
+
+    unsigned int result;
+    unsigned int inputOne, inputZero, resultOne, resultZero;
+
+    switch (gateType) {
+        case BRNCH:
+        case INV:
+            result = packValue(lineValues[inputIndex[0]]);
+            break;
+        case AND:
+        case NAND:
+            // 1 only if all inputs are 1, 0 if any input is 0.
+            result = V_ONE;
+            for (unsigned int i = 0; i < numberInputs; i++) {
+                unsigned int thisValue = packValue(lineValues[inputIndex[i]]);
+                result = (result & thisValue & V_ONE) | ((result | thisValue) & V_ZERO);
+            }
+            break;
+        case OR:
+        case NOR:
+            // 1 if any input is 1, 0 only if all inputs are 0.
+            result = V_ZERO;
+            for (unsigned int i = 0; i < numberInputs; i++) {
+                unsigned int thisValue = packValue(lineValues[inputIndex[i]]);
+                result = ((result | thisValue) & V_ONE) | (result & thisValue & V_ZERO);
+            }
+            break;
+        case XOR:
+        case XNOR:
+            // The 1 and 0 bits are lined up by shifting the 0 bits down.
+            resultOne = 0;
+            resultZero = V_ONE;
+            for (unsigned int i = 0; i < numberInputs; i++) {
+                unsigned int thisValue = packValue(lineValues[inputIndex[i]]);
+                inputOne = thisValue & V_ONE;
+                inputZero = (thisValue >> 1) & V_ONE;
+                unsigned int nextOne = (resultOne & inputZero) | (resultZero & inputOne);
+                resultZero = (resultOne & inputOne) | (resultZero & inputZero);
+                resultOne = nextOne;
+            }
+            result = resultOne | (resultZero << 1);
+            break;
+        default:
+            cerr << "Unknown gate type encountered." << endl;
+            cerr << "Possible values are 1-8. Current value is " << gateType << endl;
+            exit (1);
+            break;
     }
 
-    return (returnSet);
+    // Inverting a value swaps its 1 and 0 bits.
+    if (gateType == INV || gateType == NAND || gateType == NOR || gateType == XNOR)
+        result = ((result & V_ONE) << 1) | ((result >> 1) & V_ONE);
 
+    // Keep the value only if both the fault free and the faulty parts are known.
+    unsigned int isKnown = (result | (result >> 1)) & (V_GOOD_ONE | V_FAULT_ONE);
+    isKnown &= (isKnown >> 2);
+    return result & (0 - isKnown);
 }
 
 /*
  * ===  FUNCTION  ======================================================================
- *         Name:  forwardImlpication
- *  Description:  The function takes in an STL set as input and returns a set as output.
- *                The version defined below is a two input version.
- *                Set is used since multiple inputs may give same result.
+ *         Name:  evaluatePacked
+ *  Description:  Picks the copy of evaluatePackedInputs for the number of inputs.
  * =====================================================================================
  */
-set <int>   forwardImplication (unsigned int gateType, set <int> &input_a, set <int> &input_b) {
-
-    set <int> returnSet;
-    set <int>::iterator i, j;
-
-    for (i = input_a.begin(); i != input_a.end(); i++) {
-        for (j = input_b.begin(); j != input_b.end(); j++) {
-            switch (gateType) {
-                case AND:
-                    returnSet.insert(ANDTABLE[*i][*j]);
-                    break;
-                case NAND:
-                    returnSet.insert(NANDTABLE[*i][*j]);
-                    break;
-                case OR:
-                    returnSet.insert(ORTABLE[*i][*j]);
-                    break;
-                case NOR:
-                    returnSet.insert(NORTABLE[*i][*j]);
-                    break;
-                case XOR:
-                    returnSet.insert(XORTABLE[*i][*j]);
-                    break;
-                case XNOR:
-                    returnSet.insert(XNORTABLE[*i][*j]);
-                    break;
-                default:
-                    cerr << "Unknown gate type encountered." << endl;
-                    cerr << "Possible values are 2,3,4,6,7. Current value is " << gateType << endl;
-                    exit (0);
-                    break;
-            }
-        }
+template <typename ValueType>
+unsigned char evaluatePacked (unsigned int gateType, const ValueType *lineValues,
+                              const int *inputIndex, unsigned int numberInputs) {
+
+    switch (numberInputs) {
+        case 1:
+            return evaluatePackedInputs (gateType, lineValues, inputIndex, 1);
+        case 2:
+            return evaluatePackedInputs (gateType, lineValues, inputIndex, 2);
+        case 3:
+            return evaluatePackedInputs (gateType, lineValues, inputIndex, 3);
+        case 4:
+            return evaluatePackedInputs (gateType, lineValues, inputIndex, 4);
+        default:
+            return evaluatePackedInputs (gateType, lineValues, inputIndex, numberInputs);
     }
+}
 
-    return returnSet;
+/*
+ * ===  FUNCTION  ======================================================================
+ *         Name:  forwardImplication
+ *  Description:  Evaluates a gate on packed values. lineValues has the values of all
+ *                the lines, inputIndex has the positions of the gate inputs in it.
+ *                The packed output value is returned.
+ * =====================================================================================
+ */
+unsigned char forwardImplication (unsigned int gateType, const unsigned char *lineValues,
+                                  const int *inputIndex, unsigned int numberInputs) {
+    return evaluatePacked (gateType, lineValues, inputIndex, numberInputs);
+}
+
+/*
+ * ===  FUNCTION  ======================================================================
+ *         Name:  evaluateGate
+ *  Description:  Same as forwardImplication, but the line values and the result are
+ *                5 values (ZERO, ONE, D, B and X).
+ * =====================================================================================
+ */
+int evaluateGate (unsigned int gateType, const int *lineValues, const int *inputIndex, unsigned int numberInputs) {
+    return UNPACKTABLE[evaluatePacked (gateType, lineValues, inputIndex, numberInputs)];
+}
+
+/*-----------------------------------------------------------------------------
+ * Wider words for the fault simulator. These are GCC vector types, so the
+ * same bit operations work on them and are compiled to AVX2 (256 bits) or
+ * AVX-512 (512 bits) instructions in the functions built for those targets.
+ *
+ * The value arrays of the simulator are plain uint64_t arrays, which are not
+ * aligned to the vector size, so a word is always read and written through
+ * loadWord and storeWord (unaligned moves), never through a Word pointer.
+ *-----------------------------------------------------------------------------*/
+
+typedef uint64_t Word256 __attribute__ ((vector_size (32)));
+typedef uint64_t Word512 __attribute__ ((vector_size (64)));
+
+template <typename Word>
+ALWAYS_INLINE void loadWord (Word &outWord, const uint64_t *inValues, int inIndex) {
+    __builtin_memcpy (&outWord, inValues + inIndex * (sizeof (Word) / sizeof (uint64_t)), sizeof (Word));
+}
 
+template <typename Word>
+ALWAYS_INLINE void storeWord (uint64_t *outValues, const Word &inWord) {
+    __builtin_memcpy (outValues, &inWord, sizeof (Word));
 }
 
 /*
  * ===  FUNCTION  ======================================================================
- *         Name:  forwardImlpication
- *  Description:  The function takes in an STL set as input and returns a set as output.
- *                The version defined below is a three input version.
- *                Set is used since multiple inputs may give same result.
+ *         Name:  evaluateParallelInputs
+ *  Description:  Bit parallel version of evaluatePackedInputs, used by the fault
+ *                simulator. Every value is a pair of words. A bit set in the ONE word
+ *                means 1, a bit set in the ZERO word means 0 and neither means X. Each
+ *                bit position is a different input vector, so 64 vectors are
+ *                evaluated at once, or 256 and 512 for the wider words. The value of
+ *                line i is the Word at uint64_t number i * (size of Word / 8).
  * =====================================================================================
  */
-set <int>   forwardImplication (unsigned int gateType, set <int> &input_a, set <int> &input_b, set <int> &input_c) {
-
-    set <int> returnSet;
-    set <int>::iterator i, j;
-
-    for (i = input_a.begin(); i != input_a.end(); i++) {
-        for (j = input_b.begin(); j != input_b.end(); j++) {
-            switch (gateType) {
-                case AND:
-                case NAND:
-                    returnSet.insert(ANDTABLE[*i][*j]);
-                    break;
-                case OR:
-                case NOR:
-                    returnSet.insert(ORTABLE[*i][*j]);
-                    break;
-                case XOR:
-                case XNOR:
-                    returnSet.insert(XORTABLE[*i][*j]);
-                    break;
-                default:
-                    cerr << "Unknown gate type encountered." << endl;
-                    cerr << "Possible values are 2,3,4,6,7. Current value is " << gateType << endl;
-                    exit (0);
-                    break;
+template <typename Word>
+ALWAYS_INLINE void evaluateParallelInputs (unsigned int gateType, const uint64_t *valueOne, const uint64_t *valueZero,
+                                           const int *inputIndex, unsigned int numberInputs,
+                                           uint64_t *outOne, uint64_t *outZero) {
+
+    Word resultOne, resultZero, inputOne, inputZero, swapValue;
+
+    loadWord (resultOne, valueOne, inputIndex[0]);
+    loadWord (resultZero, valueZero, inputIndex[0]);
+
+    switch (gateType) {
+        case BRNCH:
+        case INV:
+            break;
+        case AND:
+        case NAND:
+            for (unsigned int i = 1; i < numberInputs; i++) {
+                loadWord (inputOne, valueOne, inputIndex[i]);
+                loadWord (inputZero, valueZero, inputIndex[i]);
+                resultOne &= inputOne;
+                resultZero |= inputZero;
             }
-        }
+            break;
+        case OR:
+        case NOR:
+            for (unsigned int i = 1; i < numberInputs; i++) {
+                loadWord (inputOne, valueOne, inputIndex[i]);
+                loadWord (inputZero, valueZero, inputIndex[i]);
+                resultOne |= inputOne;
+                resultZero &= inputZero;
+            }
+            break;
+        case XOR:
+        case XNOR:
+            for (unsigned int i = 1; i < numberInputs; i++) {
+                loadWord (inputOne, valueOne, inputIndex[i]);
+                loadWord (inputZero, valueZero, inputIndex[i]);
+                swapValue = (resultOne & inputZero) | (resultZero & inputOne);
+                resultZero = (resultOne & inputOne) | (resultZero & inputZero);
+                resultOne = swapValue;
+            }
+            break;
+        default:
+            cerr << "Unknown gate type encountered." << endl;
+            cerr << "Possible values are 1-8. Current value is " << gateType << endl;
+            exit (1);
+            break;
+    }
+
+    // Inverting a value swaps its 1 and 0 bits, X stays X.
+    if (gateType == INV || gateType == NAND || gateType == NOR || gateType == XNOR) {
+        swapValue = resultOne;
+        resultOne = resultZero;
+        resultZero = swapValue;
+    }
+
+    storeWord (outOne, resultOne);
+    storeWord (outZero, resultZero);
+}
+
+/*
+ * ===  FUNCTION  ======================================================================
+ *         Name:  evaluateParallel
+ *  Description:  Calls evaluateParallelInputs with the number of inputs fixed for
+ *                gates with up to 4 inputs.
+ * =====================================================================================
+ */
+template <typename Word>
+ALWAYS_INLINE void evaluateParallel (unsigned int gateType, const uint64_t *valueOne, const uint64_t *valueZero,
+                                     const int *inputIndex, unsigned int numberInputs, uint64_t *outOne, uint64_t *outZero) {
+
+    switch (numberInputs) {
+        case 1:
+            evaluateParallelInputs <Word> (gateType, valueOne, valueZero, inputIndex, 1, outOne, outZero);
+            break;
+        case 2:
+            evaluateParallelInputs <Word> (gateType, valueOne, valueZero, inputIndex, 2, outOne, outZero);
+            break;
+        case 3:
+            evaluateParallelInputs <Word> (gateType, valueOne, valueZero, inputIndex, 3, outOne, outZero);
+            break;
+        case 4:
+            evaluateParallelInputs <Word> (gateType, valueOne, valueZero, inputIndex, 4, outOne, outZero);
+            break;
+        default:
+            evaluateParallelInputs <Word> (gateType, valueOne, valueZero, inputIndex, numberInputs, outOne, outZero);
+            break;
     }
+}
+
+/*
+ * ===  FUNCTION  ======================================================================
+ *         Name:  evaluateGateParallel
+ *  Description:  Evaluates a gate for 64 vectors. valueOne and valueZero have the
+ *                values of all the lines, inputIndex has the positions of the gate
+ *                inputs in them.
+ * =====================================================================================
+ */
+void evaluateGateParallel (unsigned int gateType, const uint64_t *valueOne, const uint64_t *valueZero,
+                           const int *inputIndex, unsigned int numberInputs, uint64_t &outOne, uint64_t &outZero) {
+    evaluateParallel <uint64_t> (gateType, valueOne, valueZero, inputIndex, numberInputs, &outOne, &outZero);
+}
 
-    return (forwardImplication (gateType, input_c, returnSet));
+/*-----------------------------------------------------------------------------
+ * Wide gate evaluation. The values of a line take a block of 1, 4 or 8 words
+ * in valueOne and valueZero, so the line with index i starts at word i times
+ * the block size. The output is written to the block at outOne and outZero.
+ *
+ * There is one function per block size. The 4 and 8 word versions are built
+ * for AVX2 and AVX-512 only, and are used only if the processor has them.
+ *-----------------------------------------------------------------------------*/
+
+typedef void (*WideGateFunction) (unsigned int gateType, const uint64_t *valueOne, const uint64_t *valueZero,
+                                  const int *inputIndex, unsigned int numberInputs, uint64_t *outOne, uint64_t *outZero);
+
+void evaluateGateWide64 (unsigned int gateType, const uint64_t *valueOne, const uint64_t *valueZero,
+                         const int *inputIndex, unsigned int numberInputs, uint64_t *outOne, uint64_t *outZero) {
+    evaluateParallel <uint64_t> (gateType, valueOne, valueZero, inputIndex, numberInputs, outOne, outZero);
+}
+
+#if (defined(__x86_64__) || defined(__i386__)) && MAX_SIMULATION_WORDS >= 4
+__attribute__ ((target ("avx2")))
+void evaluateGateWide256 (unsigned int gateType, const uint64_t *valueOne, const uint64_t *valueZero,
+                          const int *inputIndex, unsigned int numberInputs, uint64_t *outOne, uint64_t *outZero) {
+    evaluateParallel <Word256> (gateType, valueOne, valueZero, inputIndex, numberInputs, outOne, outZero);
+}
+#endif
+
+#if (defined(__x86_64__) || defined(__i386__)) && MAX_SIMULATION_WORDS >= 8
+__attribute__ ((target ("avx512f")))
+void evaluateGateWide512 (unsigned int gateType, const uint64_t *valueOne, const uint64_t *valueZero,
+                          const int *inputIndex, unsigned int numberInputs, uint64_t *outOne, uint64_t *outZero) {
+    evaluateParallel <Word512> (gateType, valueOne, valueZero, inputIndex, numberInputs, outOne, outZero);
+}
+#endif
+
+/*
+ * ===  FUNCTION  ======================================================================
+ *         Name:  selectWideGate
+ *  Description:  Returns the widest gate evaluation function the processor can run,
+ *                up to MAX_SIMULATION_WORDS words, and its block size in outWords.
+ *                The plain 64 bit version runs everywhere.
+ * =====================================================================================
+ */
+WideGateFunction selectWideGate (int &outWords) {
+
+    #if (defined(__x86_64__) || defined(__i386__)) && MAX_SIMULATION_WORDS >= 8
+        if (__builtin_cpu_supports ("avx512f")) {
+            outWords = 8;
+            return evaluateGateWide512;
+        }
+    #endif
+    #if (defined(__x86_64__) || defined(__i386__)) && MAX_SIMULATION_WORDS >= 4
+        if (__builtin_cpu_supports ("avx2")) {
+            outWords = 4;
+            return evaluateGateWide256;
+        }
+    #endif
 
+    outWords = 1;
+    return evaluateGateWide64;
 }
 
 } /* namespace nameSpace_ATPG */